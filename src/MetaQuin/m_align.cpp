@@ -19,13 +19,11 @@ static MAlign::Stats init()
     {
         const auto &cID = i.first;
         
-        /*
-         * We'd like to know the length of the genome but we don't have the information.
-         * It doesn't matter because we can simply initalize it to the the maximum possible.
-         */
-        
-        stats.data[cID].bLvl.fp = std::shared_ptr<MergedInterval>
-                (new MergedInterval(cID, Locus(1, std::numeric_limits<Base>::max())));
+        auto &x = stats.data[cID];
+
+        // Counters are indexed by the ordinals of the regions
+        x.lGaps = x.rGaps = x.align = OrdinalCounts<Base>(i.second);
+        x.aLvl.r2r = OrdinalCounts<Counts>(i.second);
     }
     
     return stats;
@@ -39,6 +37,7 @@ static void classifyAlign(MAlign::Stats &stats, ParserSAM::Data &align)
     }
     
     auto &x = stats.data.at(align.cID);
+    auto &inters = stats.inters.at(align.cID);
     
     Locus l;
     bool spliced;
@@ -61,9 +60,9 @@ static void classifyAlign(MAlign::Stats &stats, ParserSAM::Data &align)
             
             const auto covered = (l.length() - lGaps - rGaps);
             
-            stats.data[align.cID].lGaps[m->name()] += lGaps;
-            stats.data[align.cID].lGaps[m->name()] += rGaps;
-            stats.data[align.cID].align[m->name()] += covered;
+            x.lGaps[*m] += lGaps;
+            x.rGaps[*m] += rGaps;
+            x.align[*m] += covered;
             
             A_ASSERT(covered >= 0);
             A_ASSERT(l.length() > lGaps);
@@ -71,7 +70,7 @@ static void classifyAlign(MAlign::Stats &stats, ParserSAM::Data &align)
         };
         
         // Does the read aligned within a region (eg: gene)?
-        const auto m = stats.inters.at(align.cID).contains(l);
+        const auto m = inters.contains(l);
         
         if (m)
         {
@@ -80,18 +79,18 @@ static void classifyAlign(MAlign::Stats &stats, ParserSAM::Data &align)
             f(m);
             A_CHECK("lGaps == 0 && rGaps == 0", "No gaps expected for a TP");
             
-            stats.data[align.cID].tp++;
-            x.aLvl.r2r[m->id()]++;
+            x.tp++;
+            x.aLvl.r2r[*m]++;
         }
         else
         {
             // At the alignment level, anything but a perfect match is a FP
             isTP = false;
             
-            x.afp.push_back(align.name);
+            stats.afp.add(align.cID, align.name);
             
             // Can we at least match by overlapping?
-            const auto m = stats.inters[align.cID].overlap(l);
+            const auto m = inters.overlap(l);
             
             if (m)
             {
@@ -103,7 +102,7 @@ static void classifyAlign(MAlign::Stats &stats, ParserSAM::Data &align)
                 {
                     const auto gap = Locus(l.start, m->l().start-1);
                     
-                    x.bLvl.fp->map(gap);
+                    x.bLvl.fp.add(gap);
                 }
                 
                 // Gap to the right?
@@ -111,14 +110,14 @@ static void classifyAlign(MAlign::Stats &stats, ParserSAM::Data &align)
                 {
                     const auto gap = Locus(m->l().end+1, l.end);
                     
-                    x.bLvl.fp->map(gap);
+                    x.bLvl.fp.add(gap);
                 }
                 
-                stats.data[align.cID].fp++;
+                x.fp++;
             }
             else if (isMetaQuin(align.cID))
             {
-                stats.data[align.cID].fp++;
+                x.fp++;
             }
         }
     }
@@ -136,6 +135,17 @@ static void classifyAlign(MAlign::Stats &stats, ParserSAM::Data &align)
 MAlign::Stats MAlign::analyze(const FileName &file, const Options &o)
 {
     auto stats = init();
+
+    if (o.fpStream)
+    {
+        // Written while the alignments are parsed rather than with the other outputs
+        o.generate("MetaAlign_fpreads.txt.gz");
+        stats.afp.stream(o.work + "/MetaAlign_fpreads.txt.gz");
+    }
+    else if (o.fpSample)
+    {
+        stats.afp.sample(o.fpSample);
+    }
     
     auto classify = [&](ParserSAM::Data &x, const ParserSAM::Info &info)
     {
@@ -183,6 +193,9 @@ MAlign::Stats MAlign::analyze(const FileName &file, const Options &o)
         classify(align, info);
     });
     
+    // Everything has been streamed
+    stats.afp.close();
+    
     /*
      * -------------------- Calculating statistics --------------------
      */
@@ -238,12 +251,10 @@ MAlign::Stats MAlign::analyze(const FileName &file, const Options &o)
             else
             {
                 // TP at the base level
-                const auto btp = stats.data.at(cID).align.count(rID) ? stats.data.at(cID).align.at(rID) : 0;
+                const auto btp = stats.data.at(cID).align[*m];
                 
                 // FP at the base level (requires overlapping)
-                const auto bfp = (stats.data.at(i.first).lGaps.count(rID) ? stats.data.at(i.first).lGaps.at(rID) : 0)
-                +
-                (stats.data.at(i.first).rGaps.count(rID) ? stats.data.at(i.first).rGaps.at(rID) : 0);
+                const auto bfp = stats.data.at(cID).lGaps[*m] + stats.data.at(cID).rGaps[*m];
                 
                 A_ASSERT(!isnan(btp) && btp >= 0);
                 A_ASSERT(!isnan(bfp) && bfp >= 0);
@@ -299,18 +310,18 @@ MAlign::Stats MAlign::analyze(const FileName &file, const Options &o)
         const auto ts = stats.inters.at(cID).stats();
         
         // Statistics for the non-reference region (FP)
-        const auto fs = x.bLvl.fp->stats();
+        const auto fs = x.bLvl.fp.length();
         
         if (isMetaQuin(cID))
         {
             stats.sb.tp() += ts.nonZeros;
-            stats.sb.fp() += fs.nonZeros;
+            stats.sb.fp() += fs;
             stats.sb.fn() += ts.length - ts.nonZeros;
         }
         else
         {
             stats.gb.tp() += ts.nonZeros;
-            stats.gb.fp() += fs.nonZeros;
+            stats.gb.fp() += fs;
             stats.gb.fn() += ts.length - ts.nonZeros;
         }
     }
@@ -477,7 +488,7 @@ static void writeQuins(const FileName &file, const MAlign::Stats &stats, const M
                 const auto &x = stats.data.at(cID);
                 
                 // Number of reads mapped to the region
-                const auto reads = x.aLvl.r2r.count(sID) ? x.aLvl.r2r.at(sID) : 0;
+                const auto reads = x.aLvl.r2r[j.second];
                 
                 o.writer->write((boost::format(format) % sID
                                                        % stats.s2l.at(sID)
@@ -493,26 +504,14 @@ static void writeQuins(const FileName &file, const MAlign::Stats &stats, const M
 
 static void writeQueries(const FileName &file, const MAlign::Stats &stats, const MAlign::Options &o)
 {
-#ifdef DEBUG_MALIGN
-    o.generate(file);
-    o.writer->open(file);
-    
-    const auto format = "%1%\t%2%";
-    o.writer->write((boost::format(format) % "Reads" % "Label").str());
-    
-    for (const auto &i : stats.data)
+    // Streamed FP reads have already been written
+    if (!o.fpSample)
     {
-        if (isMetaQuin(i.first))
-        {
-            for (const auto &j : i.second.afp)
-            {
-                o.writer->write((boost::format(format) % j % "FP").str());
-            }
-        }
+        return;
     }
     
-    o.writer->close();
-#endif
+    o.generate(file);
+    ReadNames::write(stats.afp.sampled(), o.work + "/" + file);
 }
 
 void MAlign::report(const std::vector<FileName> &files, const Options &o)
@@ -534,10 +533,10 @@ void MAlign::report(const std::vector<FileName> &files, const Options &o)
     writeQuins("MetaAlign_sequins.csv", stats[0], o);
     
     /*
-     * Generating MetaAlign_queries.stats (for debugging)
+     * Generating MetaAlign_fpreads.txt.gz (sampled FP reads)
      */
 
-    writeQueries("MetaAlign_queries.stats", stats[0], o);
+    writeQueries("MetaAlign_fpreads.txt.gz", stats[0], o);
     
     /*
      * Generating MetaAlign_rbase.stats (for debugging)
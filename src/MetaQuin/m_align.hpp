@@ -2,13 +2,16 @@
 #define M_ALIGN_HPP
 
 #include "data/data.hpp"
+#include "data/loci.hpp"
+#include "data/minters.hpp"
 #include "stats/analyzer.hpp"
+#include "tools/read_names.hpp"
 
 namespace Anaquin
 {
     struct MAlign
     {
-        typedef AnalyzerOptions Options;
+        typedef FPReadOptions Options;
         
         struct Stats : public AlignmentStats
         {
@@ -17,15 +20,15 @@ namespace Anaquin
                 struct BaseLevel
                 {
                     // Used for FP aligning outside the reference region
-                    std::shared_ptr<MergedInterval> fp;
+                    LocusSet fp;
                 };
                 
                 struct AlignLevel
                 {
                     Confusion m;
                     
-                    // Regions to reads (sequins for synthetic)
-                    std::map<RegionID, Coverage> r2r;
+                    // Regions to reads (sequins for synthetic), indexed by ordinals
+                    OrdinalCounts<Counts> r2r;
                 };
                 
                 // Base level for a chromosome
@@ -37,15 +40,14 @@ namespace Anaquin
                 // Overall TP and FP (for each chromosome)
                 Counts tp, fp;
                 
-                // FP alignments (overlaps)
-                std::vector<ReadID> afp;
-                
-                std::map<GeneID, Base> lGaps;
-                std::map<GeneID, Base> rGaps;
-                std::map<GeneID, Base> align;
+                // Bases to the left, right and within the regions, indexed by ordinals
+                OrdinalCounts<Base> lGaps, rGaps, align;
             };
             
             std::map<ChrID, Data> data;
+
+            // Names of FP alignments (only if requested)
+            ReadNames afp;
             
             std::map<ChrID, MergedIntervals<>> inters;
             
@@ -93,7 +95,16 @@ namespace Anaquin
             
             for (const auto &file : files)
             {
-                stats.push_back(analyze(file, o));
+                auto x = o;
+                
+                // Only the first sample is reported, there's no need to collect FP reads for the others
+                if (!stats.empty())
+                {
+                    x.fpStream = false;
+                    x.fpSample = 0;
+                }
+                
+                stats.push_back(analyze(file, x));
             }
             
             return stats;
@@ -1,5 +1,6 @@
 #include "tools/errors.hpp"
 #include "tools/gtf_data.hpp"
+#include "tools/gtf_index.hpp"
 #include "RnaQuin/r_align.hpp"
 #include "RnaQuin/RnaQuin.hpp"
 #include "parsers/parser_sam.hpp"
@@ -64,14 +65,11 @@ static RAlign::Stats init()
         // Number of unique reference introns
         stats.data[cID].iLvl.m.nr() = r.countUIntr(cID);
 
-        /*
-         * We'd like to know the length of the chromosome but we don't have the information.
-         * It doesn't matter because we can simply initalize it to the the maximum possible.
-         * The data structure in MergedInterval will be efficient not to waste memory.
-         */
+        // Most junctions are reference introns, a rehash would leave the old buckets in the arena
+        stats.data[cID].iLvl.juncs.reserve(r.countUIntr(cID));
 
-        MergedInterval *mi = new MergedInterval(cID, Locus(1, std::numeric_limits<Base>::max()));
-        stats.data[cID].bLvl.fp = std::shared_ptr<MergedInterval>(mi);
+        // Counters are indexed by the ordinals of the merged exons
+        stats.data[cID].e2r = OrdinalCounts<Counts>(i.second);
         
         A_CHECK(stats.data[cID].eLvl.nr(), "stats.data[cID].eLvl.nr()");
     }
@@ -84,6 +82,9 @@ RAlign::Stats calculate(const RAlign::Options &o, std::function<void (RAlign::St
 {
     const auto &r = Standard::instance().r_rna;
 
+    // Junctions and FP introns are released with the statistics
+    Arena::Scope scope(std::make_shared<Arena>());
+
     auto stats = init();
 
 #ifdef ANAQUIN_DEBUG
@@ -95,6 +96,24 @@ RAlign::Stats calculate(const RAlign::Options &o, std::function<void (RAlign::St
     // Parsing input files
     f(stats);
 
+    // For each chromosome...
+    for (auto &i : stats.data)
+    {
+        // For each junction...
+        for (const auto &j : i.second.iLvl.juncs)
+        {
+            if (j.second.match)
+            {
+                // We'll use it to calculate sensitivty at the intron level
+                j.second.match->map(j.first);
+            }
+            else
+            {
+                i.second.iLvl.fp.insert(j.first);
+            }
+        }
+    }
+
 #ifdef ANAQUIN_DEBUG
     __iWriter__.close();
     __bWriter__.close();
@@ -133,7 +152,7 @@ RAlign::Stats calculate(const RAlign::Options &o, std::function<void (RAlign::St
          * Calculating statistics for bases
          */
 
-        const auto bfp = x.bLvl.fp->stats().nonZeros;
+        const auto bfp = x.bLvl.fp.length();
         const auto btp = es.nonZeros;
         const auto bfn = bs.length - bs.nonZeros;
 
@@ -196,6 +215,13 @@ RAlign::Stats calculate(const RAlign::Options &o, std::function<void (RAlign::St
         }
     }
     
+    // Chromosomes without alignments weren't loaded, nothing on them is detected
+    for (const auto &i : r.skipped())
+    {
+        stats.gbm.fn() += i.second.eLen;
+        stats.gim.fn() += i.second.iInters;
+    }
+
     stats.sem.fn() = r.countUExonSyn();
     stats.gem.fn() = r.countUExonGen();
 
@@ -208,6 +234,8 @@ static void match(RAlign::Stats &stats, const ParserSAM::Info &info, ParserSAM::
     static bool spliced;
 
     auto &x = stats.data.at(align.cID);
+    auto &eInters = stats.eInters.at(align.cID);
+    auto &iInters = stats.iInters.at(align.cID);
 
     if (info.skip)
     {
@@ -222,26 +250,32 @@ static void match(RAlign::Stats &stats, const ParserSAM::Info &info, ParserSAM::
     // This'll be set to false whenever there is a mismatch
     bool isTP = true;
     
-    GeneID gID = "";
+    // Last exon matched by the alignment
+    const MergedInterval *gMatch = nullptr;
 
     // Check all cigar blocks...
     while (align.nextCigar(l, spliced))
     {
         if (spliced)
         {
-            // Can we find an exact match for the intron?
-            auto match = stats.iInters.at(align.cID).exact(l);
+            /*
+             * Junctions are highly redundant, only look for an exact match for the intron the first
+             * time a junction is seen. Mapping and FP are resolved after all alignments.
+             */
             
-            if (match)
+            auto &j = x.iLvl.juncs[l];
+            
+            if (!j.n++)
             {
-                // We'll use it to calculate sensitivty at the intron level
-                match->map(l);
+                j.match = iInters.exact(l);
+            }
 
-                writeIntron(align.cID, l, match->gID(), "TP");
+            if (j.match)
+            {
+                writeIntron(align.cID, l, j.match->gID(), "TP");
             }
             else
             {
-                x.iLvl.fp.insert(l);
                 isTP = false;
 
                 writeIntron(align.cID, l, "", "FP");
@@ -250,7 +284,7 @@ static void match(RAlign::Stats &stats, const ParserSAM::Info &info, ParserSAM::
         else
         {
             // Can we find an contained match for the exon?
-            const auto match = stats.eInters.at(align.cID).contains(l);
+            const auto match = eInters.contains(l);
             
 #ifdef DEBUG_ANAQUIN
             if (ms.size() > 1)
@@ -265,14 +299,14 @@ static void match(RAlign::Stats &stats, const ParserSAM::Info &info, ParserSAM::
                 // We'll need it for calculating sensitivity at the base level
                 match->map(l);
                 
-                gID = match->gID();
+                gMatch = match;
 
                 writeBase(align.cID, l, "TP");
             }
             else
             {
                 // Can we find an overlapping match for the exon?
-                const auto match = stats.eInters.at(align.cID).overlap(l);
+                const auto match = eInters.overlap(l);
 
                 if (match)
                 {
@@ -283,7 +317,7 @@ static void match(RAlign::Stats &stats, const ParserSAM::Info &info, ParserSAM::
                     {
                         const auto gap = Locus(l.start, match->l().start-1);
                         
-                        x.bLvl.fp->map(gap);
+                        x.bLvl.fp.add(gap);
                         
                         writeBase(align.cID, gap, "FP");
                     }
@@ -293,7 +327,7 @@ static void match(RAlign::Stats &stats, const ParserSAM::Info &info, ParserSAM::
                     {
                         const auto gap = Locus(match->l().end+1, l.end);
                         
-                        x.bLvl.fp->map(gap);
+                        x.bLvl.fp.add(gap);
                         
                         writeBase(align.cID, gap, "FP");
                     }
@@ -301,7 +335,7 @@ static void match(RAlign::Stats &stats, const ParserSAM::Info &info, ParserSAM::
                 else
                 {
                     // The entire locus is outside of the reference region
-                    x.bLvl.fp->map(l);
+                    x.bLvl.fp.add(l);
                     
                     writeBase(align.cID, l, "FPO");
                 }
@@ -316,8 +350,8 @@ static void match(RAlign::Stats &stats, const ParserSAM::Info &info, ParserSAM::
     {
         x.aLvl.m.tp()++;
 
-        A_CHECK(!gID.empty(), "!gID.empty()");
-        x.g2r[gID]++;
+        A_CHECK(gMatch, "gMatch");
+        x.e2r[*gMatch]++;
     }
     else
     {
@@ -331,6 +365,8 @@ RAlign::Stats RAlign::analyze(const FileName &file, const Options &o)
     
     return calculate(o, [&](RAlign::Stats &stats)
     {
+        stats.windows = CoverageTool::Windows(o.window);
+        
         ParserSAM::parse(file, [&](ParserSAM::Data &x, const ParserSAM::Info &info)
         {
             if (info.p.i && !(info.p.i % 1000000))
@@ -338,6 +374,11 @@ RAlign::Stats RAlign::analyze(const FileName &file, const Options &o)
                 o.wait(std::to_string(info.p.i));
             }
 
+            if (o.window)
+            {
+                stats.windows.add(x);
+            }
+
             // Don't count for multiple alignments
             if (!x.mapped || x.isPrimary)
             {
@@ -409,7 +450,7 @@ static void generateSummary(const FileName &file,
                             const RAlign::Options &o)
 {
     const auto &r = Standard::instance().r_rna;
-    const auto hasGeno = stats.data.size() > 1;
+    const auto hasGeno = stats.data.size() + r.skipped().size() > 1;
     
     #define G(x) (hasGeno ? toString(x) : "-")
     
@@ -533,6 +574,9 @@ static void writeQuins(const FileName &file,
         if (isRnaQuin(cID))
         {
             std::map<GeneID, Confusion> bm, im;
+            
+            // Number of reads aligned to the genes
+            std::map<GeneID, Counts> g2r;
 
 #ifdef ANAQUIN_DEBUG
             std::map<GeneID, Confusion> em;
@@ -597,18 +641,18 @@ static void writeQuins(const FileName &file,
 
                 bm[gID].tp() += bs.nonZeros;
                 bm[gID].fn() += bs.length - bs.nonZeros;
+                
+                g2r[gID] += i.second.e2r[j.second];
             }
             
             // For every gene in the reference
             for (const auto &j : h2g.at(cID))
             {
-                const auto &data = i.second;
-                
                 // Eg: R1_1
                 const auto &gID = j.first;
                 
                 // Number of reads aligned
-                const auto reads = data.g2r.count(gID) ? data.g2r.at(gID) : 0;
+                const auto reads = g2r.count(gID) ? g2r.at(gID) : 0;
 
                 // Sensitivity at the intron level
                 const auto isn = im.count(gID) ? std::to_string(im.at(gID).sn()) : "-";
@@ -656,4 +700,14 @@ void RAlign::report(const FileName &file, const Options &o)
      */
     
     writeBQuins("RnaAlign_rbase.txt", file, stats, o);
+    
+    /*
+     * Generating RnaAlign_windows.bedgraph.gz
+     */
+    
+    if (o.window)
+    {
+        o.generate("RnaAlign_windows.bedgraph.gz");
+        CoverageTool::bedGraph(stats.windows, o.work + "/RnaAlign_windows.bedgraph.gz");
+    }
 }
@@ -7,7 +7,10 @@
 #ifndef R_ALIGN_HPP
 #define R_ALIGN_HPP
 
+#include "data/loci.hpp"
+#include "data/arena.hpp"
 #include "stats/analyzer.hpp"
+#include "tools/coverage.hpp"
 
 namespace Anaquin
 {
@@ -15,7 +18,7 @@ namespace Anaquin
     {
         public:
 
-            typedef AnalyzerOptions Options;
+            typedef WindowOptions Options;
 
             struct Stats : public AlignmentStats
             {
@@ -34,8 +37,20 @@ namespace Anaquin
                     
                     struct IntronLevel
                     {
+                        struct Junction
+                        {
+                            // Number of spliced blocks
+                            Counts n = 0;
+                            
+                            // Matching reference intron, resolved when the junction is first seen
+                            MergedInterval *match = nullptr;
+                        };
+                        
+                        // Junctions (skipped regions) in the alignments
+                        ArenaUMap<Locus, Junction> juncs;
+                        
                         // Unique introns considered FP
-                        std::set<Locus> fp;
+                        ArenaSet<Locus> fp;
 
                         // Confusion for unique introns
                         Confusion m;
@@ -44,7 +59,7 @@ namespace Anaquin
                     struct BaseLevel
                     {
                         // Used for FP aligning outside the reference region
-                        std::shared_ptr<MergedInterval> fp;
+                        LocusSet fp;
                     };
                     
                     typedef Confusion ExonLevel;
@@ -54,7 +69,8 @@ namespace Anaquin
                     AlignLevel  aLvl;
                     IntronLevel iLvl;
 
-                    std::map<GeneID, Counts> g2r;
+                    // Reads for each merged exon (indexed by ordinals), summed for the genes in reports
+                    OrdinalCounts<Counts> e2r;
                 };
 
                 std::map<ChrID, Data> data;
@@ -77,6 +93,9 @@ namespace Anaquin
                 Counts gn = 0;
                 Counts gs = 0;
                 Confusion gbm, gam, gim, gem;
+                
+                // Genome-wide coverage (only if windows requested)
+                CoverageTool::Windows windows;
             };
 
             static Stats analyze(const FileName &, const Options &o = Options());
@@ -1,5 +1,6 @@
 #include <thread>
 #include <fstream>
+#include <functional>
 #include "tools/system.hpp"
 #include "data/compare.hpp"
 #include "tools/gtf_data.hpp"
@@ -27,57 +28,51 @@ extern FileName GTFRef();
 // Defined for Cuffcompare
 extern int cuffcompare_main(const char *ref, const char *query);
 
-static std::string exec(const char* cmd)
-{
-    char buffer[128];
-    std::string result = "";
-    std::shared_ptr<FILE> pipe(popen(cmd, "r"), pclose);
-    if (!pipe) throw std::runtime_error("popen() failed!");
-    while (!feof(pipe.get())) {
-        if (fgets(buffer, 128, pipe.get()) != NULL)
-            result += buffer;
-    }
-    
-    return result;
-}
-
-static FileName grepGTF(const FileName &file, const std::string &key, bool shouldGeneTrans = true)
+// Write the lines of the file that the filter accepts, compressed files are read as text
+static FileName filterGTF(const FileName &file, std::function<bool (boost::string_ref)> f)
 {
     const auto tmp = System::tmpFile();
 
-    std::string cmd;
-    
-    if (shouldGeneTrans)
-    {
-        cmd = "grep " + key + " " + file + " > " + tmp;
-    }
-    else
+    std::ofstream o(tmp);
+    boost::string_ref l;
+
+    for (Reader r(file); r.nextView(l);)
     {
-        cmd = "grep " + key + " " + file + " | grep -v gene_type | grep -v transcript_type > " + tmp;
+        if (f(l))
+        {
+            o.write(l.data(), l.size());
+            o << '\n';
+        }
     }
-    
-    const auto msg = exec(cmd.c_str());
-    
-    if (!msg.empty())
+
+    o.close();
+
+    if (!o)
     {
-        A_THROW("Failed to execute: " + msg);
+        A_THROW("Failed to write: " + tmp);
     }
 
     return tmp;
 }
 
+// Same as grep, lines with the key
+static FileName grepGTF(const FileName &file, const std::string &key, bool shouldGeneTrans = true)
+{
+    return filterGTF(file, [&](boost::string_ref l)
+    {
+        return l.find(key) != boost::string_ref::npos &&
+              (shouldGeneTrans || (l.find("gene_type")       == boost::string_ref::npos &&
+                                   l.find("transcript_type") == boost::string_ref::npos));
+    });
+}
+
+// Same as grep -v, lines without the key
 static FileName grepVGTF(const FileName &file, const std::string &key)
 {
-    const auto tmp = System::tmpFile();
-    const auto cmd = "grep -v " + key + " " + file + " > " + tmp;
-    const auto msg = exec(cmd.c_str());
-    
-    if (!msg.empty())
+    return filterGTF(file, [&](boost::string_ref l)
     {
-        A_THROW("Failed to execute: " + msg);
-    }
-    
-    return tmp;
+        return l.find(key) == boost::string_ref::npos;
+    });
 }
 
 static FileName createQGTFSyn(const FileName &file)
@@ -102,7 +97,7 @@ static FileName createRGTFGen(const FileName &file)
 
 static void readQueryGTF(const FileName &file)
 {
-    const auto gs = gtfData(Reader(file));
+    const auto gs = gtfData(Reader(file), std::thread::hardware_concurrency());
     
     __Stats__->sExons = gs.countUExonSyn();
     __Stats__->sIntrs = gs.countUIntrSyn();
@@ -116,7 +111,7 @@ static void readQueryGTF(const FileName &file)
 
 static void readRefGTF(const FileName &file)
 {
-    __RData__ = gtfData(Reader(file));
+    __RData__ = gtfData(Reader(file), std::thread::hardware_concurrency());
 }
 
 static RAssembly::Stats init(const RAssembly::Options &o)
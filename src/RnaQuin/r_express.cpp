@@ -198,7 +198,7 @@ RExpress::Stats RExpress::analyze(const FileName &file, const Options &o)
             {
                 ParserExpress::Data t;
 
-                ParserGTF::parse(file, [&](const ParserGTF::Data &x, const std::string &, const ParserProgress &p)
+                ParserGTF::parse(file, [&](const ParserGTF::Data &x, boost::string_ref, const ParserProgress &p)
                 {
                     if (p.i && !(p.i % 100000))
                     {
@@ -29,14 +29,11 @@ static VAlign::Stats init()
     {
         const auto &cID = i.first;
         
-        /*
-         * We'd like to know the length of the chromosome but we don't have the information.
-         * It doesn't matter because we can simply initalize it to the the maximum possible.
-         * The data structure in MergedInterval will be efficient not to waste memory.
-         */
-        
-        MergedInterval *mi = new MergedInterval(cID, Locus(1, std::numeric_limits<Base>::max()));
-        stats.data[cID].bLvl.fp = std::shared_ptr<MergedInterval>(mi);
+        auto &x = stats.data[cID];
+
+        // Counters are indexed by the ordinals of the regions
+        x.lGaps = x.rGaps = x.align = OrdinalCounts<Base>(i.second);
+        x.aLvl.r2r = OrdinalCounts<Counts>(i.second);
     }
 
     return stats;
@@ -50,6 +47,7 @@ static void classifyAlign(VAlign::Stats &stats, ParserSAM::Data &align)
     }
     
     auto &x = stats.data.at(align.cID);
+    auto &inters = stats.inters.at(align.cID);
 
     Locus l;
     bool spliced;
@@ -72,9 +70,9 @@ static void classifyAlign(VAlign::Stats &stats, ParserSAM::Data &align)
             
             const auto covered = (l.length() - lGaps - rGaps);
             
-            stats.data[align.cID].lGaps[m->name()] += lGaps;
-            stats.data[align.cID].lGaps[m->name()] += rGaps;
-            stats.data[align.cID].align[m->name()] += covered;
+            x.lGaps[*m] += lGaps;
+            x.rGaps[*m] += rGaps;
+            x.align[*m] += covered;
             
             A_ASSERT(covered >= 0);
             A_ASSERT(l.length() > lGaps);
@@ -82,7 +80,7 @@ static void classifyAlign(VAlign::Stats &stats, ParserSAM::Data &align)
         };
         
         // Does the read aligned within a region?
-        const auto m = stats.inters.at(align.cID).contains(l);
+        const auto m = inters.contains(l);
 
         if (m)
         {
@@ -91,18 +89,18 @@ static void classifyAlign(VAlign::Stats &stats, ParserSAM::Data &align)
             f(m);
             A_CHECK("lGaps == 0 && rGaps == 0", "No gaps expected for a TP");
             
-            stats.data[align.cID].tp++;
-            x.aLvl.r2r[m->id()]++;
+            x.tp++;
+            x.aLvl.r2r[*m]++;
         }
         else
         {
             // At the alignment level, anything but a perfect match is a FP
             isTP = false;
             
-            x.afp.push_back(align.name);
+            stats.afp.add(align.cID, align.name);
             
             // Can we at least match by overlapping?
-            const auto m = stats.inters[align.cID].overlap(l);
+            const auto m = inters.overlap(l);
             
             if (m)
             {
@@ -114,7 +112,7 @@ static void classifyAlign(VAlign::Stats &stats, ParserSAM::Data &align)
                 {
                     const auto gap = Locus(l.start, m->l().start-1);
                     
-                    x.bLvl.fp->map(gap);
+                    x.bLvl.fp.add(gap);
                     writeBase(align.cID, gap, "FP");
                 }
                 
@@ -123,17 +121,17 @@ static void classifyAlign(VAlign::Stats &stats, ParserSAM::Data &align)
                 {
                     const auto gap = Locus(m->l().end+1, l.end);
                     
-                    x.bLvl.fp->map(gap);
+                    x.bLvl.fp.add(gap);
                     writeBase(align.cID, gap, "FP");
                 }
                 
-                stats.data[align.cID].fp++;
+                x.fp++;
                 
                 writeBase(align.cID, l, "FP");
             }
             else if (isVarQuin(align.cID))
             {
-                stats.data[align.cID].fp++;
+                x.fp++;
                 
                 /*
                  * The read is not aligned within the reference regions. We don't know whether this is
@@ -157,7 +155,21 @@ static void classifyAlign(VAlign::Stats &stats, ParserSAM::Data &align)
 
 VAlign::Stats VAlign::analyze(const FileName &gen, const FileName &seqs, const Options &o)
 {
+    // The statistics for the sequins and genes are released together
+    Arena::Scope scope(std::make_shared<Arena>());
+
     auto stats = init();
+
+    if (o.fpStream)
+    {
+        // Written while the alignments are parsed rather than with the other outputs
+        o.generate("VarAlign_fpreads.txt.gz");
+        stats.afp.stream(o.work + "/VarAlign_fpreads.txt.gz");
+    }
+    else if (o.fpSample)
+    {
+        stats.afp.sample(o.fpSample);
+    }
     
     o.info(std::to_string(stats.inters.size()) + " chromosomes in the reference");
 
@@ -252,6 +264,9 @@ VAlign::Stats VAlign::analyze(const FileName &gen, const FileName &seqs, const O
     __bWriter__.close();
 #endif
 
+    // Everything has been streamed
+    stats.afp.close();
+
     o.info("Alignments analyzed. Generating statistics...");
     
     /*
@@ -311,12 +326,10 @@ VAlign::Stats VAlign::analyze(const FileName &gen, const FileName &seqs, const O
             else
             {
                 // TP at the base level
-                const auto btp = stats.data.at(cID).align.count(rID) ? stats.data.at(cID).align.at(rID) : 0;
+                const auto btp = stats.data.at(cID).align[*m];
                 
                 // FP at the base level (requires overlapping)
-                const auto bfp = (stats.data.at(i.first).lGaps.count(rID) ? stats.data.at(i.first).lGaps.at(rID) : 0)
-                                                +
-                                 (stats.data.at(i.first).rGaps.count(rID) ? stats.data.at(i.first).rGaps.at(rID) : 0);
+                const auto bfp = stats.data.at(cID).lGaps[*m] + stats.data.at(cID).rGaps[*m];
                 
                 A_ASSERT(!isnan(btp) && btp >= 0);
                 A_ASSERT(!isnan(bfp) && bfp >= 0);
@@ -372,18 +385,18 @@ VAlign::Stats VAlign::analyze(const FileName &gen, const FileName &seqs, const O
         const auto ts = stats.inters.at(cID).stats();
         
         // Statistics for the non-reference region (FP)
-        const auto fs = x.bLvl.fp->stats();
+        const auto fs = x.bLvl.fp.length();
         
         if (isReverseGenome(cID))
         {
             stats.sb.tp() += ts.nonZeros;
-            stats.sb.fp() += fs.nonZeros;
+            stats.sb.fp() += fs;
             stats.sb.fn() += ts.length - ts.nonZeros;
         }
         else
         {
             stats.gb.tp() += ts.nonZeros;
-            stats.gb.fp() += fs.nonZeros;
+            stats.gb.fp() += fs;
             stats.gb.fn() += ts.length - ts.nonZeros;
         }
     }
@@ -555,7 +568,7 @@ static void writeQuins(const FileName &file, const VAlign::Stats &stats, const V
                 const auto &x = stats.data.at(cID);
                 
                 // Number of reads mapped to the region
-                const auto reads = x.aLvl.r2r.count(sID) ? x.aLvl.r2r.at(sID) : 0;
+                const auto reads = x.aLvl.r2r[j.second];
                 
                 o.writer->write((boost::format(format) % sID
                                                        % stats.s2l.at(sID)
@@ -571,26 +584,14 @@ static void writeQuins(const FileName &file, const VAlign::Stats &stats, const V
 
 static void writeQueries(const FileName &file, const VAlign::Stats &stats, const VAlign::Options &o)
 {
-#ifdef DEBUG_VALIGN
-    o.generate(file);
-    o.writer->open(file);
-    
-    const auto format = "%1%\t%2%";
-    o.writer->write((boost::format(format) % "Reads" % "Label").str());
-
-    for (const auto &i : stats.data)
+    // Streamed FP reads have already been written
+    if (!o.fpSample)
     {
-        if (isVarQuin(i.first))
-        {
-            for (const auto &j : i.second.afp)
-            {
-                o.writer->write((boost::format(format) % j % "FP").str());
-            }
-        }
+        return;
     }
     
-    o.writer->close();
-#endif
+    o.generate(file);
+    ReadNames::write(stats.afp.sampled(), o.work + "/" + file);
 }
 
 void VAlign::report(const FileName &gen, const FileName &seqs, const Options &o)
@@ -612,10 +613,10 @@ void VAlign::report(const FileName &gen, const FileName &seqs, const Options &o)
     writeQuins("VarAlign_sequins.csv", stats, o);
 
     /*
-     * Generating VarAlign_queries.stats (for debugging)
+     * Generating VarAlign_fpreads.txt.gz (sampled FP reads)
      */
-    
-    writeQueries("VarAlign_queries.stats", stats, o);
+
+    writeQueries("VarAlign_fpreads.txt.gz", stats, o);
 
     /*
      * Generating VarAlign_rbase.stats (for debugging)
@@ -2,13 +2,17 @@
 #define V_ALIGN_HPP
 
 #include "data/data.hpp"
+#include "data/loci.hpp"
+#include "data/arena.hpp"
+#include "data/minters.hpp"
 #include "stats/analyzer.hpp"
+#include "tools/read_names.hpp"
 
 namespace Anaquin
 {
     struct VAlign
     {
-        typedef AnalyzerOptions Options;
+        typedef FPReadOptions Options;
         
         struct Stats : public AlignmentStats
         {
@@ -17,15 +21,15 @@ namespace Anaquin
                 struct BaseLevel
                 {
                     // Used for FP aligning outside the reference region
-                    std::shared_ptr<MergedInterval> fp;
+                    LocusSet fp;
                 };
                 
                 struct AlignLevel
                 {
                     Confusion m;
                     
-                    // Regions to reads (sequins for synthetic)
-                    std::map<RegionID, Coverage> r2r;
+                    // Regions to reads (sequins for synthetic), indexed by ordinals
+                    OrdinalCounts<Counts> r2r;
                 };
                 
                 // Base level for a chromosome
@@ -37,16 +41,15 @@ namespace Anaquin
                 // Overall TP and FP (for each chromosome)
                 Counts tp, fp;
 
-                // FP alignments (overlaps)
-                std::vector<ReadID> afp;
-
-                std::map<GeneID, Base> lGaps;
-                std::map<GeneID, Base> rGaps;
-                std::map<GeneID, Base> align;
+                // Bases to the left, right and within the regions, indexed by ordinals
+                OrdinalCounts<Base> lGaps, rGaps, align;
             };
 
             std::map<ChrID, Data> data;
 
+            // Names of FP alignments (only if requested)
+            ReadNames afp;
+
             std::map<ChrID, MergedIntervals<>> inters;
             
             /*
@@ -69,22 +72,22 @@ namespace Anaquin
             Confusion gb;
             
             // Sequins to covered (synthetic)
-            std::map<SequinID, Base> s2c;
+            ArenaMap<SequinID, Base> s2c;
             
             // Sequins to length (synthetic)
-            std::map<SequinID, Base> s2l;
+            ArenaMap<SequinID, Base> s2l;
             
             // Genes to covered (genome)
-            std::map<GeneID, Base> g2c;
+            ArenaMap<GeneID, Base> g2c;
             
             // Genes to length (genome)
-            std::map<GeneID, Base> g2l;
+            ArenaMap<GeneID, Base> g2l;
             
             // Genes to precision
-            std::map<GeneID, Proportion> g2p;
+            ArenaMap<GeneID, Proportion> g2p;
             
             // Sequins to sensitivity
-            std::map<GeneID, Proportion> g2s;
+            ArenaMap<GeneID, Proportion> g2s;
         };
 
         static Stats analyze(const FileName &, const FileName &, const Options &o = Options());        
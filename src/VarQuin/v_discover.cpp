@@ -1,4 +1,8 @@
+#include <thread>
+#include <fstream>
+#include <algorithm>
 #include "data/convert.hpp"
+#include "tools/system.hpp"
 #include "VarQuin/v_discover.hpp"
 
 using namespace Anaquin;
@@ -41,68 +45,266 @@ static Scripts createVCROC(const FileName &file, const std::string &score, const
                                        % refRat).str();
 }
 
-struct VDiscoverImpl : public VCFDataUser
+static const auto format = "%1%\t%2%\t%3%\t%4%\t%5%\t%6%\t%7%\t%8%\t%9%\t%10%\t%11%\t%12%\t%13%\t%14%\t%15%\t%16%";
+
+static void writeHeader(const VDiscover::Options &o)
+{
+    o.writer->write((boost::format(format) % "ID"
+                                           % "ChrID"
+                                           % "Position"
+                                           % "Label"
+                                           % "ReadR"
+                                           % "ReadV"
+                                           % "Depth"
+                                           % "ExpRef"
+                                           % "ExpVar"
+                                           % "ExpFreq"
+                                           % "ObsFreq"
+                                           % "Pval"
+                                           % "Qual"
+                                           % "QualR"
+                                           % "QualV"
+                                           % "Type").str());
+}
+
+struct VDiscoverImpl
 {
     VDiscover::Stats *stats;
     const VDiscover::Options *o;
 
-    void variantProcessed(const ParserVCF::Data &x, const ParserProgress &p) override
+    // Merged intervals for tracing FPs to the sequins, copied once for each chromosome
+    std::map<ChrID, MergedIntervals<>> inters;
+    
+    // Parsed once and reused for every row
+    boost::format row = boost::format(format);
+    
+    /*
+     * Input variants are counted by unique positions (SNPs and indels separately). The input might
+     * not be sorted, so the positions are kept (a repeat of the last position is skipped) and made
+     * unique at the end.
+     */
+    
+    std::map<ChrID, std::vector<Base>> snps, inds;
+
+    ChrID lastCID;
+    std::vector<Base> *lastSNP = nullptr, *lastInd = nullptr;
+
+    /*
+     * Rows of VarDiscover_detected.csv are written to temporary files, one for TPs and one for FPs
+     * of each chromosome. They're put together in the order of the chromosomes, TPs before FPs.
+     */
+    
+    struct Rows
     {
-        if (p.i && !(p.i % 100000))
+        FileName tps, fps;
+    };
+    
+    std::map<ChrID, Rows> rows;
+    
+    // Files for the chromosome being written
+    ChrID rowCID;
+    std::ofstream tps, fps;
+    
+    ~VDiscoverImpl()
+    {
+        for (const auto &i : rows)
         {
-            o->wait(std::to_string(p.i));
+            std::remove(i.second.tps.c_str());
+            std::remove(i.second.fps.c_str());
+        }
+    }
+    
+    static Counts countUnique(std::map<ChrID, std::vector<Base>> &x)
+    {
+        Counts n = 0;
+        
+        for (auto &i : x)
+        {
+            std::sort(i.second.begin(), i.second.end());
+            n += std::unique(i.second.begin(), i.second.end()) - i.second.begin();
         }
         
-        const auto &r = Standard::instance().r_var;
+        return n;
+    }
+    
+    // Put together the rows for VarDiscover_detected.csv
+    void writeDetected()
+    {
+        tps.close();
+        fps.close();
         
-        VariantMatch m;
+        std::vector<char> buf(1 << 20);
 
-        auto match = [&](const ParserVCF::Data &query)
+        auto copy = [&](const FileName &file)
         {
-            m.query = query;
-            m.match = nullptr;
+            std::ifstream f(file, std::ios::binary);
             
-            const auto isSyn = isVarQuin(query.cID);
+            while (f.read(buf.data(), buf.size()) || f.gcount())
+            {
+                o->writer->write(std::string(buf.data(), f.gcount()), false);
+            }
+        };
+        
+        for (const auto &i : rows)
+        {
+            copy(i.second.tps);
+            copy(i.second.fps);
+        }
+    }
+
+    // Write the query to the temporary file for its chromosome and label
+    void addDetected(const CalledVariant &query, const Variant *match, const std::string &label)
+    {
+        const auto &r = Standard::instance().r_var;
+        const auto &cID = query.cID;
+        
+        auto sID = (match ? match->id : "-");
+        
+        if (label == "FP")
+        {
+            /*
+             * We know this is a FP, but we can trace it to one of the sequins?
+             */
             
-            if (isSyn || Standard::isGenomic(query.cID))
+            if (r.hasInters(cID))
             {
-                // Can we match by position?
-                m.match = r.findVar(query.cID, query.l);
+                if (!inters.count(cID))
+                {
+                    inters[cID] = r.mInters(cID);
+                }
+                
+                // We'll need it to search for the sequin where the FPs are
+                const auto &x = inters.at(cID);
+                
+                A_ASSERT(x.size());
+                
+                const auto m = x.contains(query.l);
                 
-                if (m.match)
+                // Can we find the corresponding region for the FP?
+                if (m)
                 {
-                    m.ref = m.match->ref == query.ref;
-                    m.alt = m.match->alt == query.alt;
+                    sID = m->id();
+                    
+                    // It has to be a sequin (eg: D_3_12)
+                    A_ASSERT(!sID.empty());
                 }
             }
+        }
+        
+        const auto eRef  = sID != "-" ? r.findRCon(sID)  : NAN;
+        const auto eVar  = sID != "-" ? r.findVCon(sID)  : NAN;
+        const auto eFreq = sID != "-" ? r.findAFreq(sID) : NAN;
+        
+        if (cID != rowCID || !tps.is_open())
+        {
+            tps.close();
+            fps.close();
+            
+            auto &x = rows[cID];
+            
+            if (x.tps.empty())
+            {
+                x.tps = System::tmpFile();
+                x.fps = System::tmpFile();
+            }
+            
+            // Revisiting a chromosome (unsorted input) appends to its rows
+            tps.open(x.tps, std::ios::app);
+            fps.open(x.fps, std::ios::app);
+            
+            if (!tps.good() || !fps.good())
+            {
+                throw std::runtime_error("Failed to open a temporary file for VarDiscover_detected.csv");
+            }
             
-            return m.match;
+            rowCID = cID;
+        }
+        
+        (label == "TP" ? tps : fps) << (row % sID
+                              % query.cID
+                              % query.l.start
+                              % label
+                              % query.readR
+                              % query.readV
+                              % query.depth
+                              % eRef
+                              % eVar
+                              % eFreq
+                              % query.alleleFreq()
+                              % ld2ss(query.p)
+                              % x2ns(query.qual)
+                              % x2ns(query.qualR)
+                              % x2ns(query.qualV)
+                              % type2str(query.type())).str() << "\n";
+    }
+
+    void variantProcessed(const ParserVCF::Data &query, const ParserProgress &p)
+    {
+        if (p.i && !(p.i % 100000))
+        {
+            o->wait(std::to_string(p.i));
+        }
+        
+        const auto &r = Standard::instance().r_var;
+        const auto &cID = query.cID;
+        const auto type = query.type();
+
+        if (cID != lastCID || !lastSNP)
+        {
+            lastCID = cID;
+            lastSNP = &snps[cID];
+            lastInd = &inds[cID];
+        }
+        
+        auto add = [&](std::vector<Base> &x)
+        {
+            if (x.empty() || x.back() != query.l.start)
+            {
+                x.push_back(query.l.start);
+            }
         };
-     
-        match(x);
         
-        const auto &cID = m.query.cID;
+        switch (type)
+        {
+            case Mutation::SNP:       { add(*lastSNP); break; }
+            case Mutation::Deletion:
+            case Mutation::Insertion: { add(*lastInd); break; }
+        }
+
+        const Variant *match = nullptr;
         
+        // Only matching if the position and alleles agree
+        auto matched = false;
+
         auto f = [&]()
         {
-            if (!isnan(m.query.p))     { __countP__++; }
-            if (!isnan(m.query.depth)) { __countD__++; }
+            if (!isnan(query.p))     { __countP__++; }
+            if (!isnan(query.depth)) { __countD__++; }
 
-            // Only matching if the position and alleles agree
-            const auto matched = m.match && m.ref && m.alt;
+            // Can we match by position?
+            match = r.findVar(cID, query.l);
+            matched = match && match->ref == query.ref && match->alt == query.alt;
+            
+            auto &x = stats->data[cID];
             
             if (matched)
             {
-                const auto key = m.match->key();
+                const auto key = match->key();
                 stats->hist.at(cID).at(key)++;
                 
-                stats->data[cID].tps.push_back(m);
-                stats->data[cID].tps_[key] = stats->data[cID].tps.back();
+                x.tps[key] = VDiscover::Stats::Data::Match { query.readR,
+                                                             query.readV,
+                                                             query.depth,
+                                                             query.alleleFreq(),
+                                                             query.p,
+                                                             query.qual,
+                                                             query.qualR,
+                                                             query.qualV };
                 
-                stats->data.at(cID).af = m.query.alleleFreq();
+                x.af = query.alleleFreq();
                 
-                const auto exp = r.findAFreq(baseID(m.match->id));
-                const auto obs = m.query.alleleFreq();
+                const auto exp = r.findAFreq(baseID(match->id));
+                const auto obs = query.alleleFreq();
                 
                 // Eg: 2821292107
                 const auto id = toString(key);
@@ -110,33 +312,37 @@ struct VDiscoverImpl : public VCFDataUser
                 // Add for all variants
                 stats->vars.add(id, exp, obs);
                 
-                switch (m.query.type())
+                x.m.tp()++;
+                
+                switch (type)
                 {
-                    case Mutation::SNP:       { stats->snp.add(id, exp, obs); break; }
+                    case Mutation::SNP:       { x.m_snp.tp()++; stats->snp.add(id, exp, obs); break; }
                     case Mutation::Deletion:
-                    case Mutation::Insertion: { stats->ind.add(id, exp, obs); break; }
+                    case Mutation::Insertion: { x.m_ind.tp()++; stats->ind.add(id, exp, obs); break; }
                 }
                 
-                stats->readR[key] = m.query.readR;
-                stats->readV[key] = m.query.readV;
-                stats->depth[key] = m.query.depth;
-                
                 if (isnan(stats->vars.limit.abund) || exp < stats->vars.limit.abund)
                 {
-                    stats->vars.limit.id = m.match->id;
+                    stats->vars.limit.id = match->id;
                     stats->vars.limit.abund = exp;
                 }
             }
             else
             {
                 // FP because the variant is not found in the reference
-                stats->data[cID].fps.push_back(m);
+                x.m.fp()++;
+                
+                switch (type)
+                {
+                    case Mutation::SNP:       { x.m_snp.fp()++; break; }
+                    case Mutation::Deletion:
+                    case Mutation::Insertion: { x.m_ind.fp()++; break; }
+                }
             }
+
+            addDetected(query, match, matched ? "TP" : "FP");
         };
         
-        // Always work on the queries
-        stats->query[cID].af.insert(m.query.alleleFreq());
-
         if (isVarQuin(cID))
         {
             stats->nSyn++;
@@ -158,8 +364,12 @@ VDiscover::Stats VDiscover::analyze(const FileName &file, const Options &o)
 {
     const auto &r = Standard::instance().r_var;
 
+    // The detected sequins are released with the statistics
+    Arena::Scope scope(std::make_shared<Arena>());
+
     VDiscover::Stats stats;
     stats.hist = r.vHist();
+    stats.n_snp = stats.n_ind = 0;
 
     for (const auto &i : stats.hist)
     {
@@ -172,40 +382,32 @@ VDiscover::Stats VDiscover::analyze(const FileName &file, const Options &o)
     impl.o = &o;
     impl.stats = &stats;
 
-    // Read the input variants
-    stats.vData = vcfData(file, o.format, &impl);
+    // Read the input variants, an indexed .vcf.gz or .bcf is read by regions in parallel
+    vcfStream(file, o.format, std::thread::hardware_concurrency(), [&](const ParserVCF::Data &x, const ParserProgress &p)
+    {
+        impl.variantProcessed(x, p);
+    });
+
+    stats.n_snp = VDiscoverImpl::countUnique(impl.snps);
+    stats.n_ind = VDiscoverImpl::countUnique(impl.inds);
 
+    /*
+     * Generating VarDiscover_detected.csv
+     */
+    
+    o.generate("VarDiscover_detected.csv");
+    o.writer->open("VarDiscover_detected.csv");
+    writeHeader(o);
+    impl.writeDetected();
+    o.writer->close();
+    
     o.info("Aggregating statistics");
 
-    for (const auto &i : stats.data)
+    for (auto &i : stats.data)
     {
         const auto &cID = i.first;
         
-        auto &x = stats.data[cID];
-        
-        for (const auto &j : i.second.tps)
-        {
-            i.second.m.tp()++;
-            
-            switch (j.query.type())
-            {
-                case Mutation::SNP:       { x.m_snp.tp()++; break; }
-                case Mutation::Deletion:
-                case Mutation::Insertion: { x.m_ind.tp()++; break; }
-            }
-        }
-        
-        for (const auto &j : i.second.fps)
-        {
-            i.second.m.fp()++;
-            
-            switch (j.query.type())
-            {
-                case Mutation::SNP:       { x.m_snp.fp()++; break; }
-                case Mutation::Deletion:
-                case Mutation::Insertion: { x.m_ind.fp()++; break; }
-            }
-        }
+        auto &x = i.second;
         
         x.m_snp.nq() = x.dSNP();
         x.m_snp.nr() = r.countSNP(cID);
@@ -232,26 +434,11 @@ static void writeQuins(const FileName &file,
                        const VDiscover::Options &o)
 {
     const auto &r = Standard::instance().r_var;
-    const auto format = "%1%\t%2%\t%3%\t%4%\t%5%\t%6%\t%7%\t%8%\t%9%\t%10%\t%11%\t%12%\t%13%\t%14%\t%15%\t%16%";
 
     o.generate(file);
     o.writer->open(file);
-    o.writer->write((boost::format(format) % "ID"
-                                           % "ChrID"
-                                           % "Position"
-                                           % "Label"
-                                           % "ReadR"
-                                           % "ReadV"
-                                           % "Depth"
-                                           % "ExpRef"
-                                           % "ExpVar"
-                                           % "ExpFreq"
-                                           % "ObsFreq"
-                                           % "Pval"
-                                           % "Qual"
-                                           % "QualR"
-                                           % "QualV"
-                                           % "Type").str());
+    writeHeader(o);
+
     for (const auto &i : stats.hist)
     {
         const auto &cID = i.first;
@@ -273,42 +460,32 @@ static void writeQuins(const FileName &file,
                 // Unique ID for the variant
                 const auto id = (m->id + "_" + std::to_string(m->l.start) + "_" + type);
 
-                /*
-                 * Now we need to know the label for this reference variant
-                 */
+                // The last query matching the sequin
+                const auto &x = stats.data.at(i.first).tps;
                 
-                auto f = [&](const std::map<long, VariantMatch> &x, const std::string &label)
-                {
-                    if (x.count(key))
-                    {
-                        const auto &t = x.at(key);
-                        
-                        o.writer->write((boost::format(format) % id
-                                                               % m->cID
-                                                               % m->l.start
-                                                               % label
-                                                               % t.query.readR
-                                                               % t.query.readV
-                                                               % t.query.depth
-                                                               % r.findRCon(m->id)
-                                                               % r.findVCon(m->id)
-                                                               % r.findAFreq(m->id)
-                                                               % t.query.alleleFreq()
-                                                               % ld2ss(t.query.p)
-                                                               % x2ns(t.query.qual)
-                                                               % x2ns(t.query.qualR)
-                                                               % x2ns(t.query.qualV)
-                                                               % type).str());
-                        return true;
-                    }
-                    
-                    return false;
-                };
-
-                if (!f(stats.data.at(i.first).tps_, "TP") && !f(stats.data.at(i.first).fns_, "FN"))
+                if (!x.count(key))
                 {
                     throw std::runtime_error("Failed to find hash key in writeQuins()");
                 }
+                
+                const auto &t = x.at(key);
+                
+                o.writer->write((boost::format(format) % id
+                                                       % m->cID
+                                                       % m->l.start
+                                                       % "TP"
+                                                       % t.readR
+                                                       % t.readV
+                                                       % t.depth
+                                                       % r.findRCon(m->id)
+                                                       % r.findVCon(m->id)
+                                                       % r.findAFreq(m->id)
+                                                       % t.af
+                                                       % ld2ss(t.p)
+                                                       % x2ns(t.qual)
+                                                       % x2ns(t.qualR)
+                                                       % x2ns(t.qualV)
+                                                       % type).str());
             }
             
             // Failed to detect the variant
@@ -346,96 +523,6 @@ static void writeQuins(const FileName &file,
     o.writer->close();
 }
 
-static void writeDetected(const FileName &file, const VDiscover::Stats &stats, const VDiscover::Options &o)
-{
-    const auto &r = Standard::instance().r_var;
-    const auto format = "%1%\t%2%\t%3%\t%4%\t%5%\t%6%\t%7%\t%8%\t%9%\t%10%\t%11%\t%12%\t%13%\t%14%\t%15%\t%16%";
-    
-    o.generate(file);
-    o.writer->open(file);
-    o.writer->write((boost::format(format) % "ID"
-                                           % "ChrID"
-                                           % "Position"
-                                           % "Label"
-                                           % "ReadR"
-                                           % "ReadV"
-                                           % "Depth"
-                                           % "ExpRef"
-                                           % "ExpVar"
-                                           % "ExpFreq"
-                                           % "ObsFreq"
-                                           % "Pval"
-                                           % "Qual"
-                                           % "QualR"
-                                           % "QualV"
-                                           % "Type").str());
-
-    for (const auto &i : stats.data)
-    {
-        const auto &cID = i.first;
-        
-        auto f = [&](const std::vector<VariantMatch> &x, const std::string &label)
-        {
-            for (const auto &i : x)
-            {
-                auto sID = (i.match ? i.match->id : "-");
-                
-                if (label == "FP")
-                {
-                    /*
-                     * We know this is a FP, but we can trace it to one of the sequins?
-                     */
-                    
-                    if (r.hasInters(cID))
-                    {
-                        // We'll need it to search for the sequin where the FPs are
-                        const auto inters = r.mInters(cID);
-                        
-                        A_ASSERT(inters.size());
-                        
-                        const auto m = inters.contains(i.query.l);
-                        
-                        // Can we find the corresponding region for the FP?
-                        if (m)
-                        {
-                            sID = m->id();
-                            
-                            // It has to be a sequin (eg: D_3_12)
-                            A_ASSERT(!sID.empty());
-                        }
-                    }
-                }
-                
-                const auto eRef  = sID != "-" ? r.findRCon(sID)  : NAN;
-                const auto eVar  = sID != "-" ? r.findVCon(sID)  : NAN;
-                const auto eFreq = sID != "-" ? r.findAFreq(sID) : NAN;
-                
-                o.writer->write((boost::format(format) % sID
-                                                       % i.query.cID
-                                                       % i.query.l.start
-                                                       % label
-                                                       % i.query.readR
-                                                       % i.query.readV
-                                                       % i.query.depth
-                                                       % eRef
-                                                       % eVar
-                                                       % eFreq
-                                                       % i.query.alleleFreq()
-                                                       % ld2ss(i.query.p)
-                                                       % x2ns(i.query.qual)
-                                                       % x2ns(i.query.qualR)
-                                                       % x2ns(i.query.qualV)
-                                                       % type2str(i.query.type())).str());
-            }
-        };
-        
-        f(i.second.tps, "TP");
-        f(i.second.fps, "FP");
-    }
-
-    o.writer->close();
-}
-
 static void writeSummary(const FileName &file, const FileName &src, const VDiscover::Stats &stats, const VDiscover::Options &o)
 {
     const auto &r = Standard::instance().r_var;
@@ -496,9 +583,9 @@ static void writeSummary(const FileName &file, const FileName &src, const VDisco
                                                 % r.countSNPSyn()            // 5
                                                 % r.countIndSyn()            // 6
                                                 % (r.countSNPSyn() + r.countIndSyn())
-                                                % stats.vData.countSNPSyn()  // 8
-                                                % stats.vData.countIndSyn()  // 9
-                                                % stats.vData.countVarSyn()  // 10
+                                                % stats.n_snp                // 8
+                                                % stats.n_ind                // 9
+                                                % (stats.n_snp + stats.n_ind)
                                                 % stats.countSNP_TP_Syn()    // 11
                                                 % stats.countInd_TP_Syn()    // 12
                                                 % stats.countVar_TP_Syn()    // 13
@@ -586,9 +673,9 @@ static void writeSummary(const FileName &file, const FileName &src, const VDisco
                                                 % r.countSNPGen()            // 8
                                                 % r.countIndGen()            // 9
                                                 % (r.countSNPGen() + r.countIndGen())
-                                                % stats.vData.countSNPSyn()  // 11
-                                                % stats.vData.countIndSyn()  // 12
-                                                % stats.vData.countVarSyn()  // 13
+                                                % stats.n_snp                // 11
+                                                % stats.n_ind                // 12
+                                                % (stats.n_snp + stats.n_ind)
                                                 % stats.vars.limit.abund     // 14
                                                 % stats.vars.limit.id        // 15
                                                 % stats.countSNP_TP_Syn()    // 16
@@ -660,12 +747,6 @@ void VDiscover::report(const FileName &file, const Options &o)
     
     writeSummary("VarDiscover_summary.stats", file, stats, o);
     
-    /*
-     * Generating VarDiscover_detected.csv
-     */
-    
-    writeDetected("VarDiscover_detected.csv", stats, o);
-    
     /*
      * Generating VarDiscover_ROC.R
      */
@@ -1,8 +1,7 @@
 #ifndef V_DISCOVER_HPP
 #define V_DISCOVER_HPP
 
-#include <set>
-#include <vector>
+#include "data/arena.hpp"
 #include "stats/analyzer.hpp"
 #include "tools/vcf_data.hpp"
 #include "VarQuin/VarQuin.hpp"
@@ -25,21 +24,13 @@ namespace Anaquin
                 // Measured minor allele frequency
                 Proportion af;
                 
-                inline Counts count(const std::vector<VariantMatch> &data, Mutation type) const
-                {
-                    return std::count_if(data.begin(), data.end(), [&](const VariantMatch &d)
-                    {
-                        return (d.query.type() == type) ? 1 : 0;
-                    });
-                }
-
-                inline Counts tpTot() const { return tps.size(); }
-                inline Counts tpSNP() const { return count(tps, Mutation::SNP); }
-                inline Counts tpInd() const { return tpTot() - tpSNP(); }
+                inline Counts tpTot() const { return m.tp(); }
+                inline Counts tpSNP() const { return m_snp.tp(); }
+                inline Counts tpInd() const { return m_ind.tp(); }
 
-                inline Counts fpTot() const { return fps.size(); }
-                inline Counts fpSNP() const { return count(fps, Mutation::SNP); }
-                inline Counts fpInd() const { return fpTot() - fpSNP(); }
+                inline Counts fpTot() const { return m.fp(); }
+                inline Counts fpSNP() const { return m_snp.fp(); }
+                inline Counts fpInd() const { return m_ind.fp(); }
 
                 inline Counts fnTot() const { return m.fn(); }
                 inline Counts fnSNP() const { return m_snp.fn(); }
@@ -53,16 +44,24 @@ namespace Anaquin
                 inline Counts dSNP() const { return tpSNP() + fpSNP() /*+ tnSNP() */+ fnSNP(); }
                 inline Counts dInd() const { return tpInd() + fpInd() /*+ tnInd() */+ fnInd(); }
                 
-                std::vector<VariantMatch> fps, tps;
-
-                std::map<long, VariantMatch> fns_, tps_;
+                // What's reported for a detected sequin, taken from the last query matching it
+                struct Match
+                {
+                    Counts readR, readV, depth;
+                    Proportion af;
+                    Probability p;
+                    double qual, qualR, qualV;
+                };
+
+                // Detected sequins by their keys
+                ArenaMap<long, Match> tps;
                 
-                // Performance metrics
+                // Performance metrics, counted as the queries are matched
                 Confusion m, m_snp, m_ind;
             };
 
-            inline Counts countTP(const ChrID& cID) const { return data.at(cID).tps.size(); }
-            inline Counts countFP(const ChrID& cID) const { return data.at(cID).fps.size(); }
+            inline Counts countTP(const ChrID& cID) const { return data.at(cID).tpTot(); }
+            inline Counts countFP(const ChrID& cID) const { return data.at(cID).fpTot(); }
             inline Counts countFN(const ChrID& cID) const { return data.at(cID).m.fn(); }
 
             inline Counts countSNP_TP(const ChrID& cID) const { return data.at(cID).tpSNP(); }
@@ -201,29 +200,13 @@ namespace Anaquin
                 return (Proportion)countInd_TP_Syn() / (countInd_TP_Syn() + countInd_FP_Syn());
             }
             
-            VCFData vData;
-            
             // Distribution for the variants
             std::map<ChrID, HashHist> hist;
 
             std::map<ChrID, Data> data;
 
-            /*
-             * Structure for the query data. This is important because we might not be given
-             * an annoation for the genome but we still might need to calculate number of variants
-             * with allele frequency below and above the LOQ.
-             */
-            
-            struct QueryData
-            {
-                // Measured allele frequency
-                std::set<Proportion> af;
-            };
-
             struct VarStats : public SequinStats, public LimitStats {};
             
-            std::map<ChrID, QueryData> query;
-
             /*
              * Statistics for allele frequency
              */
@@ -236,12 +219,13 @@ namespace Anaquin
             
             // Statistics for indels
             VarStats ind;
-            
-            std::map<long, Counts> readR;
-            std::map<long, Counts> readV;
-            std::map<long, Counts> depth;
         };
 
+        /*
+         * The query variants are matched as they're parsed, each is written to VarDiscover_detected.csv
+         * and only the counts and the detected sequins are kept.
+         */
+
         static Stats analyze(const FileName &, const Options &o = Options());
         static void report(const FileName &, const Options &o = Options());
     };
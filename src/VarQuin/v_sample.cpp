@@ -130,9 +130,6 @@ C2Intervals VSample::trimInters(const C2Intervals &c2i, const VSample::Options &
             }
             else
             {
-                // It's important to do that before we manipulate the positions
-                l.add(l.key());
-
                 l.end   -= o.edge;
                 l.start += o.edge;
             }
@@ -158,6 +155,9 @@ VSample::Stats VSample::analyze(const FileName &gen, const FileName &seq, const
     
     VSample::Stats stats;
     
+    stats.genWins = CoverageTool::Windows(o.window);
+    stats.synWins = CoverageTool::Windows(o.window);
+
     // Regions to subsample
     const auto refs = r.dInters();
     
@@ -176,6 +176,11 @@ VSample::Stats VSample::analyze(const FileName &gen, const FileName &seq, const
             stats.totBefore.nGen++;
         }
         
+        if (o.window)
+        {
+            stats.genWins.add(x);
+        }
+        
         return ReaderBam::Response::OK;
     });
     
@@ -195,6 +200,11 @@ VSample::Stats VSample::analyze(const FileName &gen, const FileName &seq, const
             stats.totBefore.nSyn++;
         }
 
+        if (o.window)
+        {
+            stats.synWins.add(x);
+        }
+
         return ReaderBam::Response::OK;
     });
     
@@ -219,10 +229,10 @@ VSample::Stats VSample::analyze(const FileName &gen, const FileName &seq, const
             const auto &l = j.second.l();
             
             // Genomic statistics within the region
-            const auto gs = gStats.inters.at(cID).find(l.key())->stats();
+            const auto gs = gStats.inters.at(cID).find(j.first)->stats();
             
             // Synthetic statistics within the region
-            const auto ss = sStats.inters.at(cID).find(l.key())->stats();
+            const auto ss = sStats.inters.at(cID).find(j.first)->stats();
             
             o.info("Calculating coverage for the synthetic and genome");
             
@@ -469,4 +479,17 @@ void VSample::report(const FileName &gen, const FileName &seqs, const Options &o
      */
 
     generateCSV("VarSubsample_sequins.csv", stats, o);
+    
+    /*
+     * Generating VarSubsample_genome.bedgraph.gz and VarSubsample_sequins.bedgraph.gz
+     */
+    
+    if (o.window)
+    {
+        o.generate("VarSubsample_genome.bedgraph.gz");
+        CoverageTool::bedGraph(stats.genWins, o.work + "/VarSubsample_genome.bedgraph.gz");
+
+        o.generate("VarSubsample_sequins.bedgraph.gz");
+        CoverageTool::bedGraph(stats.synWins, o.work + "/VarSubsample_sequins.bedgraph.gz");
+    }
 }
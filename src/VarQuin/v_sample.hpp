@@ -60,9 +60,12 @@ namespace Anaquin
             GenomeSequins sampBefore, sampAfter;
             
             std::map<ChrID, std::map<Locus, SampledInfo>> c2v;
+            
+            // Genome-wide coverage before subsampling (only if windows requested)
+            CoverageTool::Windows genWins, synWins;
         };
 
-        struct Options : public AnalyzerOptions
+        struct Options : public WindowOptions
         {
             Options() {}
             
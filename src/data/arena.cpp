@@ -0,0 +1,45 @@
+#include <algorithm>
+#include "data/arena.hpp"
+
+using namespace Anaquin;
+
+// Blocks grow up to this size, larger allocations get a block of their own
+static const std::size_t MaxBlock = 4 * 1024 * 1024;
+
+static thread_local std::shared_ptr<Arena> __current__;
+
+Arena::~Arena()
+{
+    for (auto i : _blocks)
+    {
+        delete[] i;
+    }
+}
+
+std::uintptr_t Arena::grow(std::size_t n, std::size_t align)
+{
+    const auto size = std::max(_block, n + align);
+
+    _blocks.push_back(new char[size]);
+    _block = std::min(2 * _block, MaxBlock);
+
+    const auto p = reinterpret_cast<std::uintptr_t>(_blocks.back());
+
+    _end = p + size;
+    return (p + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+}
+
+std::shared_ptr<Arena> Arena::current()
+{
+    return __current__;
+}
+
+Arena::Scope::Scope(std::shared_ptr<Arena> x) : _prev(std::move(__current__))
+{
+    __current__ = std::move(x);
+}
+
+Arena::Scope::~Scope()
+{
+    __current__ = std::move(_prev);
+}
@@ -0,0 +1,152 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <map>
+#include <set>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+namespace Anaquin
+{
+    /*
+     * Monotonic buffer for containers that are filled once and released together (eg: statistics
+     * of an analysis). Memory comes from large blocks, nothing is given back until the arena is
+     * destroyed. Not thread-safe, threads should allocate from their own arenas.
+     */
+
+    class Arena
+    {
+        public:
+
+            explicit Arena(std::size_t block = 64 * 1024) : _block(block) {}
+
+            ~Arena();
+
+            Arena(const Arena &) = delete;
+            Arena &operator=(const Arena &) = delete;
+
+            inline void *allocate(std::size_t n, std::size_t align)
+            {
+                auto p = (_p + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+
+                if (!_p || p + n > _end)
+                {
+                    p = grow(n, align);
+                }
+
+                _p = p + n;
+                _allocs++;
+                _bytes += n;
+
+                return reinterpret_cast<void *>(p);
+            }
+
+            // Number of allocations served
+            inline std::size_t allocs() const { return _allocs; }
+
+            // Number of bytes served
+            inline std::size_t bytes() const { return _bytes; }
+
+            // Number of blocks taken from the heap
+            inline std::size_t blocks() const { return _blocks.size(); }
+
+            // Arena for the containers created by this thread, null for the heap
+            static std::shared_ptr<Arena> current();
+
+            /*
+             * Containers created by this thread while the scope is alive are allocated from the
+             * arena, the previous arena is restored when the scope ends.
+             */
+
+            class Scope
+            {
+                public:
+
+                    explicit Scope(std::shared_ptr<Arena>);
+
+                    ~Scope();
+
+                    Scope(const Scope &) = delete;
+                    Scope &operator=(const Scope &) = delete;
+
+                private:
+
+                    std::shared_ptr<Arena> _prev;
+            };
+
+        private:
+
+            // Start of a new block that fits the allocation
+            std::uintptr_t grow(std::size_t n, std::size_t align);
+
+            std::size_t _block;
+
+            // Free space in the last block
+            std::uintptr_t _p = 0, _end = 0;
+
+            std::size_t _allocs = 0, _bytes = 0;
+
+            std::vector<char *> _blocks;
+    };
+
+    /*
+     * Allocator drawing from the arena of the thread when the container is created, or the heap if
+     * there's none. Containers keep their arena alive, deallocation does nothing for an arena. A copy
+     * is created like a new container, so it never allocates from the arena of another thread.
+     */
+
+    template <typename T> struct ArenaAlloc
+    {
+        typedef T value_type;
+
+        typedef std::true_type  propagate_on_container_swap;
+        typedef std::true_type  propagate_on_container_move_assignment;
+        typedef std::false_type propagate_on_container_copy_assignment;
+
+        ArenaAlloc() : arena(Arena::current()) {}
+
+        explicit ArenaAlloc(std::shared_ptr<Arena> arena) : arena(std::move(arena)) {}
+
+        template <typename U> ArenaAlloc(const ArenaAlloc<U> &x) : arena(x.arena) {}
+
+        inline ArenaAlloc select_on_container_copy_construction() const
+        {
+            return ArenaAlloc();
+        }
+
+        inline T *allocate(std::size_t n)
+        {
+            return static_cast<T *>(arena ? arena->allocate(n * sizeof(T), alignof(T)) : ::operator new(n * sizeof(T)));
+        }
+
+        inline void deallocate(T *p, std::size_t)
+        {
+            if (!arena)
+            {
+                ::operator delete(p);
+            }
+        }
+
+        std::shared_ptr<Arena> arena;
+    };
+
+    template <typename T, typename U> bool operator==(const ArenaAlloc<T> &x, const ArenaAlloc<U> &y)
+    {
+        return x.arena == y.arena;
+    }
+
+    template <typename T, typename U> bool operator!=(const ArenaAlloc<T> &x, const ArenaAlloc<U> &y)
+    {
+        return x.arena != y.arena;
+    }
+
+    template <typename K, typename V, typename C = std::less<K>> using ArenaMap = std::map<K, V, C, ArenaAlloc<std::pair<const K, V>>>;
+
+    template <typename T, typename C = std::less<T>> using ArenaSet = std::set<T, C, ArenaAlloc<T>>;
+
+    template <typename K, typename V, typename H = std::hash<K>> using ArenaUMap = std::unordered_map<K, V, H, std::equal_to<K>, ArenaAlloc<std::pair<const K, V>>>;
+}
+
+#endif
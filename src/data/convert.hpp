@@ -2,10 +2,16 @@
 #define CONVERT_HPP
 
 #include <cmath>
+#include <cerrno>
+#include <cctype>
 #include <string>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
+#include <boost/utility/string_ref.hpp>
 
 namespace Anaquin
 {
@@ -14,34 +20,133 @@ namespace Anaquin
         return isnan(p) ? "-" : std::to_string(p);
     }
     
-    inline double s2d(const std::string &x)
+    /*
+     * Numbers are parsed in place from a field of a line. The conversion functions need a terminated
+     * string, so the field is copied onto the stack (or the heap if it's unusually long).
+     */
+
+    template <typename T, typename F> T parseNum(boost::string_ref x, F f, bool &ok)
+    {
+        char buf[64];
+        std::string tmp;
+
+        const char *p = buf;
+
+        if (x.size() < sizeof(buf))
+        {
+            std::memcpy(buf, x.data(), x.size());
+            buf[x.size()] = '\0';
+        }
+        else
+        {
+            tmp = x.to_string();
+            p = tmp.c_str();
+        }
+
+        char *end;
+        errno = 0;
+
+        const T r = f(p, &end);
+
+        // Same as stod(), trailing characters are ignored but a number must be there and in range
+        ok = end != p && errno != ERANGE;
+
+        return r;
+    }
+
+    inline double s2d(boost::string_ref x)
     {
         if (x == "NA" || x == "-")
         {
             return NAN;
         }
-        
-        try
+
+        bool ok;
+        const auto r = parseNum<double>(x, std::strtod, ok);
+
+        if (!ok)
+        {
+            throw std::runtime_error("Failed to parse \"" + x.to_string() + "\". This is not a number.");
+        }
+
+        return r;
+    }
+
+    // Same as stof() for a field of a line, the values keep single precision
+    inline float s2f(boost::string_ref x)
+    {
+        bool ok;
+        const auto r = parseNum<float>(x, std::strtof, ok);
+
+        if (!ok)
         {
-            return stod(x);
+            throw std::runtime_error("Failed to parse \"" + x.to_string() + "\". This is not a number.");
         }
-        catch(...)
+
+        return r;
+    }
+
+    // Same as stold() for a field of a line
+    inline long double s2ld(boost::string_ref x)
+    {
+        bool ok;
+        const auto r = parseNum<long double>(x, std::strtold, ok);
+
+        if (!ok)
+        {
+            throw std::runtime_error("Failed to parse \"" + x.to_string() + "\". This is not a number.");
+        }
+
+        return r;
+    }
+
+    // Same as stoll() for a field of a line, but without going through a string
+    inline long long s2i(boost::string_ref x)
+    {
+        auto i = x.begin();
+
+        while (i != x.end() && std::isspace(static_cast<unsigned char>(*i))) { i++; }
+
+        const auto neg = i != x.end() && *i == '-';
+
+        if (i != x.end() && (*i == '-' || *i == '+'))
+        {
+            i++;
+        }
+
+        long long n = 0;
+        const auto start = i;
+
+        for (; i != x.end() && *i >= '0' && *i <= '9'; i++)
         {
-            throw std::runtime_error("Failed to parse \"" + x + "\". This is not a number.");
+            if (n > (LLONG_MAX - (*i - '0')) / 10)
+            {
+                throw std::runtime_error("Failed to parse \"" + x.to_string() + "\". The number is too large.");
+            }
+
+            n = 10 * n + (*i - '0');
+        }
+
+        if (i == start)
+        {
+            throw std::runtime_error("Failed to parse \"" + x.to_string() + "\". This is not a number.");
         }
+
+        return neg ? -n : n;
     }
 
-    inline long double ss2ld(const std::string &s)
+    inline long double ss2ld(boost::string_ref s)
     {
         if (s == "NA" || s == "-" || s == "*")
         {
             return NAN;
         }
 
-        std::istringstream os(s);
-        long double p;
-        os >> p;
-        return p;
+        // Zero if it's not a number, same as reading from a stream
+        bool ok;
+        const auto p = parseNum<long double>(s, std::strtold, ok);
+
+        return ok || errno == ERANGE ? p : 0;
     }
     
     inline std::string ld2ss(long double p)
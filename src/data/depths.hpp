@@ -0,0 +1,216 @@
+#ifndef DEPTHS_HPP
+#define DEPTHS_HPP
+
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <assert.h>
+#include <algorithm>
+#include "data/data.hpp"
+#include "data/hist.hpp"
+#include "data/kernels.hpp"
+
+namespace Anaquin
+{
+    /*
+     * Sequencing depth for a region, stored as a difference array. Each base keeps a 32-bit delta
+     * (alignments starting minus alignments ending), and the deltas are allocated in fixed-size
+     * blocks only where alignments land. The last block is cut to the end of the region, so a short
+     * interval only needs a delta for each of its bases. A whole chromosome, or even Locus(1, max),
+     * costs nothing until it's covered.
+     */
+
+    class DepthBlocks
+    {
+        public:
+
+            typedef DepthKernels::Value Delta;
+
+            // Number of bases in a block
+            static const Base BlockSize = 8192;
+
+            DepthBlocks(Base length = 0) : _length(length) {}
+
+            DepthBlocks(const DepthBlocks &x) : _length(x._length), _blocks(x._blocks) {}
+
+            inline DepthBlocks &operator=(const DepthBlocks &x)
+            {
+                _last   = nullptr;
+                _length = x._length;
+                _blocks = x._blocks;
+
+                return *this;
+            }
+
+            // Add an alignment covering [start, end], relative to the beginning of the region
+            inline void add(Base start, Base end)
+            {
+                assert(start <= end);
+
+                if (end < 0 || start >= _length)
+                {
+                    return;
+                }
+
+                delta(std::max(start, static_cast<Base>(0)))++;
+
+                // Nothing to close if the alignment runs to the end of the region
+                if (end + 1 < _length)
+                {
+                    delta(end + 1)--;
+                }
+            }
+
+            // Length of the region
+            inline Base length() const { return _length; }
+
+            // Number of blocks allocated
+            inline Counts countBlocks() const { return _blocks.size(); }
+
+            // Memory for the deltas (in bytes)
+            inline std::size_t memory() const
+            {
+                std::size_t n = 0;
+
+                for (const auto &i : _blocks)
+                {
+                    n += i.second.capacity() * sizeof(Delta);
+                }
+
+                return n;
+            }
+
+            /*
+             * Apply the function to every run of constant depth, (start, end, depth) where the run
+             * is half-open and relative to the beginning of the region. Unallocated blocks don't
+             * change the depth and are covered by the surrounding run.
+             */
+
+            template <typename F> void runs(F f) const
+            {
+                Base depth = 0;
+                Base lastStart = 0;
+
+                for (const auto &i : _blocks)
+                {
+                    const auto offset = i.first * BlockSize;
+                    const auto n = blockLength(i.first);
+                    const auto x = i.second.data();
+
+                    for (Base j = 0; j < n; j++)
+                    {
+                        // Depth only changes where the delta is non-zero, skip the others in bulk
+                        if (!x[j] && (j = DepthKernels::nextChange(x, j, n)) == n)
+                        {
+                            break;
+                        }
+
+                        const auto pos = offset + j;
+
+                        if (pos > lastStart)
+                        {
+                            f(lastStart, pos, depth);
+                        }
+
+                        lastStart = pos;
+                        depth += x[j];
+                    }
+                }
+
+                if (_length > lastStart)
+                {
+                    f(lastStart, _length, depth);
+                }
+            }
+
+            /*
+             * Histogram and summary statistics for the whole region. Allocated blocks are expanded
+             * into depth one block at a time, unallocated blocks are constant.
+             */
+
+            inline void hist(DepthHist &h, DepthKernels::Summary &s) const
+            {
+                // Add a run of constant depth
+                auto constant = [&](Delta depth, Base n)
+                {
+                    if (n)
+                    {
+                        h.add(depth, n);
+
+                        s.sums += depth * n;
+                        s.min   = std::min(s.min, depth);
+                        s.max   = std::max(s.max, depth);
+
+                        if (!depth) { s.zeros += n; }
+                    }
+                };
+
+                Delta depth = 0;
+
+                // First base not yet counted
+                Base pos = 0;
+
+                std::vector<Delta> x(blockLength(0));
+
+                for (const auto &i : _blocks)
+                {
+                    const auto offset = i.first * BlockSize;
+                    const auto n = blockLength(i.first);
+
+                    constant(depth, offset - pos);
+
+                    depth = DepthKernels::prefixSum(i.second.data(), x.data(), n, depth);
+                    assert(depth >= 0);
+
+                    h.addBlock(x.data(), n);
+                    DepthKernels::summary(x.data(), n, s);
+
+                    pos = offset + n;
+                }
+
+                constant(depth, _length - pos);
+            }
+
+        private:
+
+            // Number of bases in a block, only the last block can be shorter
+            inline Base blockLength(Base key) const
+            {
+                const auto n = _length - key * BlockSize;
+                return n < BlockSize ? n : BlockSize;
+            }
+
+            inline Delta &delta(Base i)
+            {
+                const auto key = i / BlockSize;
+
+                // Sorted alignments tend to hit the same block
+                if (!_last || _lastKey != key)
+                {
+                    auto &b = _blocks[key];
+
+                    if (b.empty())
+                    {
+                        b.resize(blockLength(key), 0);
+                    }
+
+                    _last    = &b;
+                    _lastKey = key;
+                }
+
+                return (*_last)[i % BlockSize];
+            }
+
+            // Length of the region
+            Base _length;
+
+            // Block index to deltas
+            std::map<Base, std::vector<Delta>> _blocks;
+
+            // Most recently accessed block
+            std::vector<Delta> *_last = nullptr;
+            Base _lastKey = 0;
+    };
+}
+
+#endif
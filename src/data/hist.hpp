@@ -3,9 +3,12 @@
 
 #include <set>
 #include <map>
+#include <cmath>
 #include <string>
+#include <vector>
 #include <assert.h>
 #include "data/data.hpp"
+#include "data/kernels.hpp"
 
 namespace Anaquin
 {
@@ -14,6 +17,142 @@ namespace Anaquin
     typedef std::map<long, Counts> HashHist;
     typedef std::map<SequinID, Counts> SequinHist;
     
+    /*
+     * Histogram for sequencing depth. Low depths are counted in a dense array, deeper depths go
+     * to overflow buckets. Memory is proportional to the number of distinct depths rather than
+     * the number of bases, and quantiles can be computed without sorting the bases.
+     */
+    
+    class DepthHist
+    {
+        public:
+        
+            // Depths below this are counted in the dense array
+            static const Base DenseLimit = 1024;
+        
+            // Add n bases at the depth
+            inline void add(Base depth, Counts n = 1)
+            {
+                assert(depth >= 0 && n >= 0);
+                
+                if (depth < DenseLimit)
+                {
+                    if (depth >= static_cast<Base>(_dense.size()))
+                    {
+                        _dense.resize(depth + 1, 0);
+                    }
+                    
+                    _dense[depth] += n;
+                }
+                else
+                {
+                    _overs[depth] += n;
+                }
+                
+                _n += n;
+            }
+        
+            // Add a contiguous block of depth, one element for each base
+            inline void addBlock(const DepthKernels::Value *x, Base n)
+            {
+                _dense.resize(DenseLimit, 0);
+                DepthKernels::histogram(x, n, _dense.data(), DenseLimit, _overs);
+                _n += n;
+            }
+        
+            inline void operator+=(const DepthHist &x)
+            {
+                x.each([&](Base depth, Counts n)
+                {
+                    add(depth, n);
+                });
+            }
+        
+            // Total number of bases
+            inline Counts size() const { return _n; }
+        
+            inline bool empty() const { return !_n; }
+        
+            // Apply the function to each depth (ascending) with non-zero count
+            template <typename F> void each(F f) const
+            {
+                for (Base i = 0; i < static_cast<Base>(_dense.size()); i++)
+                {
+                    if (_dense[i])
+                    {
+                        f(i, _dense[i]);
+                    }
+                }
+                
+                for (const auto &i : _overs)
+                {
+                    f(i.first, i.second);
+                }
+            }
+
+            // Depth of the k-th base (0-based) if all bases were sorted by depth
+            inline Base at(Counts k) const
+            {
+                assert(k >= 0 && k < _n);
+                return reach(k + 1);
+            }
+        
+            // The lowest depth where the cumulative number of bases reaches n. -1 if not possible.
+            inline Base reach(Counts n) const
+            {
+                Counts i = 0;
+                
+                for (Base j = 0; j < static_cast<Base>(_dense.size()); j++)
+                {
+                    if (_dense[j] && (i += _dense[j]) >= n)
+                    {
+                        return j;
+                    }
+                }
+                
+                for (const auto &j : _overs)
+                {
+                    if ((i += j.second) >= n)
+                    {
+                        return j.first;
+                    }
+                }
+                
+                return -1;
+            }
+        
+            /*
+             * Sample quantile, identical to SS::quantile() applied to the sorted depths. Returns NAN
+             * for an empty histogram.
+             */
+        
+            inline double quantile(double p) const
+            {
+                if (!_n)
+                {
+                    return NAN;
+                }
+                
+                const auto id = (_n - 1) * p;
+                const auto lo = static_cast<Counts>(floor(id));
+                const auto hi = static_cast<Counts>(ceil(id));
+                const auto h  = id - lo;
+                
+                return (1.0 - h) * at(lo) + h * at(hi);
+            }
+        
+        private:
+        
+            // Total number of bases
+            Counts _n = 0;
+        
+            // Number of bases for depths below DenseLimit
+            std::vector<Counts> _dense;
+        
+            // Number of bases for depths at or above DenseLimit
+            std::map<Base, Counts> _overs;
+    };
+    
     template <typename T> Hist createHist(const T& t)
     {
         Hist hist;
@@ -0,0 +1,99 @@
+#include <mutex>
+#include <memory>
+#include <unordered_map>
+#include "data/intern.hpp"
+#include "tools/errors.hpp"
+#include <boost/functional/hash.hpp>
+#include <boost/utility/string_ref.hpp>
+
+using namespace Anaquin;
+
+/*
+ * Strings are kept in blocks that never move, so that a handle can be resolved without locking.
+ * A handle is only seen by other threads after it's interned.
+ */
+
+static const std::uint32_t BlockBits = 16;
+static const std::uint32_t BlockSize = 1 << BlockBits;
+static const std::uint32_t MaxBlocks = 1 << 16;
+
+namespace
+{
+    struct RefHash
+    {
+        inline std::size_t operator()(boost::string_ref x) const
+        {
+            return boost::hash_range(x.begin(), x.end());
+        }
+    };
+
+    struct Pool
+    {
+        Pool()
+        {
+            // Handle 0 is the empty string
+            intern(std::string());
+        }
+
+        std::uint32_t intern(const std::string &x)
+        {
+            std::lock_guard<std::mutex> lock(m);
+
+            const auto i = index.find(boost::string_ref(x));
+
+            if (i != index.end())
+            {
+                return i->second;
+            }
+
+            const auto n = static_cast<std::uint32_t>(index.size());
+            const auto b = n >> BlockBits;
+
+            A_CHECK(b < MaxBlocks, "Too many strings interned");
+
+            if (!blocks[b])
+            {
+                blocks[b].reset(new std::string[BlockSize]);
+            }
+
+            auto &s = blocks[b][n & (BlockSize - 1)];
+            s = x;
+
+            // The key points to the pooled string, which never moves
+            index.insert(std::make_pair(boost::string_ref(s), n));
+
+            return n;
+        }
+
+        inline const std::string &str(std::uint32_t i) const
+        {
+            return blocks[i >> BlockBits][i & (BlockSize - 1)];
+        }
+
+        std::mutex m;
+
+        std::unordered_map<boost::string_ref, std::uint32_t, RefHash> index;
+
+        std::unique_ptr<std::string[]> blocks[MaxBlocks];
+    };
+}
+
+static Pool &pool()
+{
+    static Pool p;
+    return p;
+}
+
+IStr::IStr(const std::string &x) : _i(pool().intern(x)) {}
+
+const std::string &IStr::str() const
+{
+    return pool().str(_i);
+}
+
+std::size_t IStr::size()
+{
+    auto &p = pool();
+    std::lock_guard<std::mutex> lock(p.m);
+    return p.index.size();
+}
@@ -0,0 +1,97 @@
+#ifndef INTERN_HPP
+#define INTERN_HPP
+
+#include <string>
+#include <cstdint>
+#include <ostream>
+#include <functional>
+
+namespace Anaquin
+{
+    /*
+     * Handle for a string in a process-wide pool, eg: chromosomes, genes and transcripts repeated
+     * across many records. Handles compare and hash as integers, the text is only needed for output.
+     * Interning is thread-safe, interned strings are never released.
+     */
+
+    class IStr
+    {
+        public:
+
+            // Empty string
+            IStr() : _i(0) {}
+
+            explicit IStr(const std::string &);
+
+            inline IStr &operator=(const std::string &x) { return *this = IStr(x); }
+
+            const std::string &str() const;
+
+            inline operator const std::string &() const { return str(); }
+
+            inline std::uint32_t id() const { return _i; }
+
+            inline bool empty() const { return !_i; }
+
+            inline bool operator==(const IStr &x) const { return _i == x._i; }
+            inline bool operator!=(const IStr &x) const { return _i != x._i; }
+
+            inline bool operator==(const std::string &x) const { return str() == x; }
+            inline bool operator!=(const std::string &x) const { return str() != x; }
+            inline bool operator==(const char *x) const { return str() == x; }
+            inline bool operator!=(const char *x) const { return str() != x; }
+
+            // Order of interning, not the order of the text
+            inline bool operator<(const IStr &x) const { return _i < x._i; }
+
+            struct Hash
+            {
+                inline std::size_t operator()(const IStr &x) const { return x._i; }
+            };
+
+            // Number of strings interned, including the empty string
+            static std::size_t size();
+
+        private:
+
+            std::uint32_t _i;
+    };
+
+    /*
+     * Interns strings, remembering the last one. Consecutive records often share an ID (eg: exons in
+     * a transcript), which then doesn't go to the pool.
+     */
+
+    class IStrCache
+    {
+        public:
+
+            inline const IStr &operator()(const std::string &x)
+            {
+                if (x != _x.str())
+                {
+                    _x = IStr(x);
+                }
+
+                return _x;
+            }
+
+        private:
+
+            IStr _x;
+    };
+
+    inline std::string operator+(const std::string &x, const IStr &y) { return x + y.str(); }
+    inline std::string operator+(const IStr &x, const std::string &y) { return x.str() + y; }
+    inline std::string operator+(const char *x, const IStr &y) { return x + y.str(); }
+    inline std::string operator+(const IStr &x, const char *y) { return x.str() + y; }
+
+    inline std::ostream &operator<<(std::ostream &o, const IStr &x) { return o << x.str(); }
+}
+
+namespace std
+{
+    template <> struct hash<Anaquin::IStr> : public Anaquin::IStr::Hash {};
+}
+
+#endif
@@ -3,8 +3,9 @@
 
 #include <map>
 #include <numeric>
-#include <ss/stats.hpp>
 #include "data/data.hpp"
+#include "data/depths.hpp"
+#include "data/hist.hpp"
 #include "data/itree.hpp"
 #include "data/locus.hpp"
 
@@ -34,7 +35,7 @@ namespace Anaquin
                 Counts aligns = 0;
                 
                 // Distribution for the coverage
-                std::map<Coverage, Counts> hist;
+                DepthHist hist;
             
                 // Length of the interval
                 Base length = 0;
@@ -48,16 +49,12 @@ namespace Anaquin
                 inline Proportion covered() const { return static_cast<double>(nonZeros) / length; }
             };
         
-            Interval(const IntervalID &id, const Locus &l) : _id(id), _l(l)
-            {
-                _covs.resize(l.length());
-            }
+            Interval(const IntervalID &id, const Locus &l) : _id(id), _l(l), _covs(l.length()) {}
 
+            // Add coverage relative to the beginning of the interval
             inline void add(const Locus &l)
             {
-                if (l.start < _covs.size()) { _covs[l.start].starts++; }
-                if (l.end < _covs.size())   { _covs[l.end].ends++;     }
-                else                        { _covs.back().ends++;     }
+                _covs.add(l.start, l.end);
             };
 
             inline Base map(const Locus &l, Base *lp = nullptr, Base *rp = nullptr)
@@ -74,9 +71,7 @@ namespace Anaquin
             
                 if (start <= end)
                 {
-                    _covs[start].starts++;
-                    _covs[end].ends++;
-                    assert(start < _covs.size() && end < _covs.size());
+                    _covs.add(start, end);
                 }
             
                 // Bases to the left of the interval fails to map
@@ -96,9 +91,6 @@ namespace Anaquin
             template <typename F> Stats stats(F f) const
             {
                 Stats stats;
-                
-                // Required for estimating percentile
-                std::vector<double> x;
 
                 bedGraph([&](const ChrID &id, Base i, Base j, Coverage cov)
                 {
@@ -114,25 +106,20 @@ namespace Anaquin
                     // The interval is half-open
                     const auto n = j - i;
                     
-                    stats.sums      += (n * cov);
-                    stats.length    += n;
-                    stats.hist[cov] += n;
-                    
-                    for (auto i = 0; i < n; i++)
-                    {
-                        x.push_back(cov);
-                    }
+                    stats.sums   += (n * cov);
+                    stats.length += n;
+
+                    // Percentiles come from the histogram, no need to expand the runs
+                    stats.hist.add(static_cast<Base>(cov), n);
                     
                     if (!cov) { stats.zeros    += n; }
                     else      { stats.nonZeros += n; }
                 });
             
-                std::sort(x.begin(), x.end());
-                
                 stats.mean   = stats.sums / stats.length;
-                stats.p25    = SS::quantile(x, 0.25);
-                stats.p50    = SS::quantile(x, 0.50);
-                stats.p75    = SS::quantile(x, 0.75);
+                stats.p25    = stats.hist.quantile(0.25);
+                stats.p50    = stats.hist.quantile(0.50);
+                stats.p75    = stats.hist.quantile(0.75);
                 stats.aligns = count();
 
                 return stats;
@@ -140,42 +127,33 @@ namespace Anaquin
         
             inline Stats stats() const
             {
-                return stats([&](const ChrID &id, Base i, Base j, Coverage cov)
-                {
-                    return true;
-                });
+                Stats stats;
+                DepthKernels::Summary s;
+                
+                // Nothing to filter, work on the blocks directly
+                _covs.hist(stats.hist, s);
+                
+                stats.min      = s.min;
+                stats.max      = s.max;
+                stats.sums     = s.sums;
+                stats.zeros    = s.zeros;
+                stats.length   = _covs.length();
+                stats.nonZeros = stats.length - stats.zeros;
+                stats.mean     = stats.sums / stats.length;
+                stats.p25      = stats.hist.quantile(0.25);
+                stats.p50      = stats.hist.quantile(0.50);
+                stats.p75      = stats.hist.quantile(0.75);
+                stats.aligns   = count();
+                
+                return stats;
             }
         
             template <typename T> void bedGraph(T t) const
             {
-                Base depth = 0;
-                long lastStart = -1;
-                long lastDepth = -1;
-            
-                for (auto j = 0; j < _l.length(); j++)
+                _covs.runs([&](Base i, Base j, Base depth)
                 {
-                    depth += _covs[j].starts;
-                
-                    if (depth != lastDepth)
-                    {
-                        if (lastDepth != -1)
-                        {
-                            t(_id, lastStart, j, lastDepth);
-                        }
-                    
-                        // Set current position as the new interval start + depth
-                        lastStart = j;
-                        lastDepth = depth;
-                    }
-                
-                    depth = depth - _covs[j].ends;
-                }
-            
-                // Print information about the last position
-                if (lastDepth != -1)
-                {
-                    t(_id, lastStart, _l.length(), lastDepth);
-                }
+                    t(_id, i, j, depth);
+                });
             }
 
             inline const Locus &l()       const { return _l;  }
@@ -188,12 +166,6 @@ namespace Anaquin
 
         private:
         
-            struct Depth
-            {
-                Base starts;
-                Base ends;
-            };
-        
             // The represented interval
             Locus _l;
         
@@ -202,8 +174,8 @@ namespace Anaquin
             // Number of alignments mapped to the interval
             Counts _counts = 0;
 
-            // For each base in the interval (relative to the beginning of the interval)
-            std::vector<Depth> _covs;
+            // Depth for the interval (relative to the beginning of the interval)
+            DepthBlocks _covs;
     };
     
     template <typename T = Interval> class Intervals
@@ -325,11 +297,7 @@ namespace Anaquin
                     stats.zeros    += s.zeros;
                     stats.min       = std::min(stats.min, s.min);
                     stats.max       = std::max(stats.max, s.max);
-                
-                    for (const auto &j : s.hist)
-                    {
-                        stats.hist[j.first] += j.second;
-                    }
+                    stats.hist     += s.hist;
                 }
             
                 stats.mean = stats.sums / stats.length;
@@ -404,29 +372,15 @@ namespace Anaquin
                 stats.zeros    += s.zeros;
                 stats.min       = std::min(stats.min, s.min);
                 stats.max       = std::max(stats.max, s.max);
-                
-                for (const auto &j : s.hist)
-                {
-                    stats.hist[j.first] += j.second;
-                }
+                stats.hist     += s.hist;
             }
             
             auto percent = [&](Counts n)
             {
-                Counts i = 0;
-                
-                for (const auto &p : stats.hist)
-                {
-                    i += p.second;
-                    
-                    // Have we reached our percentile?
-                    if (i >= n)
-                    {
-                        return p.first;
-                    }
-                }
+                // Have we reached our percentile?
+                const auto r = stats.hist.reach(n);
                 
-                return stats.max;
+                return r == -1 ? stats.max : static_cast<Coverage>(r);
             };
             
             stats.mean = stats.sums / stats.length;
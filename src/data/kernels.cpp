@@ -0,0 +1,244 @@
+#include <algorithm>
+#include "data/kernels.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HAS_AVX2_KERNELS
+#include <immintrin.h>
+#endif
+
+using namespace Anaquin;
+
+typedef DepthKernels::Value Value;
+
+/*
+ * ------------------------- Scalar kernels -------------------------
+ */
+
+static Base nextChangeScalar(const Value *x, Base i, Base n)
+{
+    for (; i < n; i++)
+    {
+        if (x[i])
+        {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+static Value prefixSumScalar(const Value *x, Value *y, Base n, Value depth)
+{
+    for (Base i = 0; i < n; i++)
+    {
+        y[i] = (depth += x[i]);
+    }
+
+    return depth;
+}
+
+static void summaryScalar(const Value *x, Base n, DepthKernels::Summary &s)
+{
+    for (Base i = 0; i < n; i++)
+    {
+        s.sums += x[i];
+        s.min   = std::min(s.min, x[i]);
+        s.max   = std::max(s.max, x[i]);
+
+        if (!x[i]) { s.zeros++; }
+    }
+}
+
+static inline void bucket(Value x, Counts n, Counts *dense, Base limit, std::map<Base, Counts> &overs)
+{
+    if (x < limit) { dense[x] += n; }
+    else           { overs[x] += n; }
+}
+
+static void histogramScalar(const Value *x, Base n, Counts *dense, Base limit, std::map<Base, Counts> &overs)
+{
+    for (Base i = 0; i < n; i++)
+    {
+        bucket(x[i], 1, dense, limit, overs);
+    }
+}
+
+/*
+ * ------------------------- AVX2 kernels -------------------------
+ */
+
+#ifdef HAS_AVX2_KERNELS
+
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static Base nextChangeAVX2(const Value *x, Base i, Base n)
+{
+    // Short gaps are common at high depth, check them before going wide
+    for (const auto e = std::min(i + 8, n); i < e; i++)
+    {
+        if (x[i])
+        {
+            return i;
+        }
+    }
+
+    const auto zero = _mm256_setzero_si256();
+
+    for (; i + 8 <= n; i += 8)
+    {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i));
+        const auto m = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, zero)));
+
+        // Any lane that is not zero?
+        if (m != 0xFF)
+        {
+            return i + __builtin_ctz(~m & 0xFF);
+        }
+    }
+
+    return nextChangeScalar(x, i, n);
+}
+
+AVX2 static Value prefixSumAVX2(const Value *x, Value *y, Base n, Value depth)
+{
+    Base i = 0;
+
+    auto carry = _mm256_set1_epi32(depth);
+
+    for (; i + 8 <= n; i += 8)
+    {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i));
+
+        // Scan within each 128-bit lane
+        v = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+        v = _mm256_add_epi32(v, _mm256_slli_si256(v, 8));
+
+        // Carry the last element of the low lane into the high lane
+        const auto t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3));
+        v = _mm256_add_epi32(v, _mm256_permute2x128_si256(t, t, 0x08));
+
+        v = _mm256_add_epi32(v, carry);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(y + i), v);
+
+        carry = _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(7));
+    }
+
+    return prefixSumScalar(x + i, y + i, n - i, _mm_cvtsi128_si32(_mm256_castsi256_si128(carry)));
+}
+
+AVX2 static void summaryAVX2(const Value *x, Base n, DepthKernels::Summary &s)
+{
+    Base i = 0;
+
+    const auto zero = _mm256_setzero_si256();
+
+    auto sums = _mm256_setzero_si256();
+    auto min  = _mm256_set1_epi32(s.min);
+    auto max  = _mm256_set1_epi32(s.max);
+
+    for (; i + 8 <= n; i += 8)
+    {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i));
+
+        min = _mm256_min_epi32(min, v);
+        max = _mm256_max_epi32(max, v);
+
+        // Widen to 64 bits before summing
+        sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+
+        s.zeros += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, zero))));
+    }
+
+    alignas(32) int64_t ss[4];
+    alignas(32) Value mins[8], maxs[8];
+
+    _mm256_store_si256(reinterpret_cast<__m256i *>(ss),   sums);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(mins), min);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(maxs), max);
+
+    s.sums += ss[0] + ss[1] + ss[2] + ss[3];
+
+    for (auto j = 0; j < 8; j++)
+    {
+        s.min = std::min(s.min, mins[j]);
+        s.max = std::max(s.max, maxs[j]);
+    }
+
+    summaryScalar(x + i, n - i, s);
+}
+
+AVX2 static void histogramAVX2(const Value *x, Base n, Counts *dense, Base limit, std::map<Base, Counts> &overs)
+{
+    Base i = 0;
+
+    for (; i + 8 <= n; i += 8)
+    {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i));
+        const auto m = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, _mm256_set1_epi32(x[i]))));
+
+        // Depth tends to be constant over long stretches, count the whole vector at once
+        if (m == 0xFF)
+        {
+            bucket(x[i], 8, dense, limit, overs);
+        }
+        else
+        {
+            histogramScalar(x + i, 8, dense, limit, overs);
+        }
+    }
+
+    histogramScalar(x + i, n - i, dense, limit, overs);
+}
+
+#endif
+
+/*
+ * ------------------------- Dispatching -------------------------
+ */
+
+Base  (*DepthKernels::nextChange)(const Value *, Base, Base) = nextChangeScalar;
+Value (*DepthKernels::prefixSum)(const Value *, Value *, Base, Value) = prefixSumScalar;
+void  (*DepthKernels::summary)(const Value *, Base, Summary &) = summaryScalar;
+void  (*DepthKernels::histogram)(const Value *, Base, Counts *, Base, std::map<Base, Counts> &) = histogramScalar;
+
+static bool hasAVX2()
+{
+#ifdef HAS_AVX2_KERNELS
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+bool DepthKernels::isAVX2()
+{
+#ifdef HAS_AVX2_KERNELS
+    return nextChange == nextChangeAVX2;
+#else
+    return false;
+#endif
+}
+
+void DepthKernels::use(bool avx2)
+{
+#ifdef HAS_AVX2_KERNELS
+    if (avx2 && hasAVX2())
+    {
+        nextChange = nextChangeAVX2;
+        prefixSum  = prefixSumAVX2;
+        summary    = summaryAVX2;
+        histogram  = histogramAVX2;
+
+        return;
+    }
+#endif
+
+    nextChange = nextChangeScalar;
+    prefixSum  = prefixSumScalar;
+    summary    = summaryScalar;
+    histogram  = histogramScalar;
+}
+
+// Choose the kernels once at start-up
+static const bool kernelsRegistered = (DepthKernels::use(true), true);
@@ -0,0 +1,53 @@
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+#include <map>
+#include <limits>
+#include <cstdint>
+#include "data/data.hpp"
+
+namespace Anaquin
+{
+    /*
+     * Kernels over contiguous blocks of depth (or depth deltas). AVX2 versions are chosen at runtime
+     * if the processor supports it, otherwise the scalar versions are used. Both give identical
+     * results.
+     */
+
+    struct DepthKernels
+    {
+        typedef int32_t Value;
+
+        struct Summary
+        {
+            // Number of zero elements
+            Base zeros = 0;
+
+            // Sum of all elements
+            Base sums = 0;
+
+            Value min = std::numeric_limits<Value>::max();
+            Value max = std::numeric_limits<Value>::min();
+        };
+
+        // Index of the first non-zero element in [i, n), n if there's none
+        static Base (*nextChange)(const Value *, Base i, Base n);
+
+        // Inclusive prefix sum of the deltas starting from the depth. Returns the last depth.
+        static Value (*prefixSum)(const Value *, Value *, Base n, Value depth);
+
+        // Number of zeros, sum, minimum and maximum of the elements
+        static void (*summary)(const Value *, Base n, Summary &);
+
+        // Count elements below the limit in the dense array, anything else in the overflows
+        static void (*histogram)(const Value *, Base n, Counts *dense, Base limit, std::map<Base, Counts> &);
+
+        // Whether the AVX2 kernels are in use
+        static bool isAVX2();
+
+        // Select the AVX2 kernels (only if supported) or the scalar kernels
+        static void use(bool avx2);
+    };
+}
+
+#endif
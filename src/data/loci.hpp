@@ -0,0 +1,111 @@
+#ifndef LOCI_HPP
+#define LOCI_HPP
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include "data/locus.hpp"
+
+namespace Anaquin
+{
+    /*
+     * Set of bases covered by a collection of loci. Loci are appended to a buffer and only sorted
+     * and coalesced into a flat sorted vector once the buffer is large enough (or the set is read).
+     * Overlapping loci are merged; adjacent but non-overlapping loci are kept apart, the same as
+     * MergedInterval. Unlike MergedInterval, no length is needed and nothing is allocated until
+     * the first locus is added.
+     */
+
+    class LocusSet
+    {
+        public:
+
+            // Minimum number of loci buffered before they're coalesced
+            static const std::size_t BatchSize = 4096;
+
+            inline void add(const Locus &l)
+            {
+                _buf.push_back(Locus(l.start, l.end));
+
+                // Coalescing costs the size of the set, so keep the buffer at least as large
+                if (_buf.size() >= BatchSize && _buf.size() >= _data.size())
+                {
+                    flush();
+                }
+            }
+
+            // Sorted non-overlapping loci
+            inline const std::vector<Locus> &data() const
+            {
+                flush();
+                return _data;
+            }
+
+            // Number of non-overlapping loci
+            inline std::size_t size() const { return data().size(); }
+
+            inline bool empty() const { return _data.empty() && _buf.empty(); }
+
+            // Number of bases covered
+            inline Base length() const
+            {
+                Base n = 0;
+
+                for (const auto &i : data())
+                {
+                    n += i.length();
+                }
+
+                return n;
+            }
+
+        private:
+
+            inline void flush() const
+            {
+                if (_buf.empty())
+                {
+                    return;
+                }
+
+                auto byStart = [&](const Locus &x, const Locus &y)
+                {
+                    return x.start < y.start || (x.start == y.start && x.end < y.end);
+                };
+
+                std::sort(_buf.begin(), _buf.end(), byStart);
+
+                std::vector<Locus> x;
+                x.reserve(_data.size() + _buf.size());
+                std::merge(_data.begin(), _data.end(), _buf.begin(), _buf.end(), std::back_inserter(x), byStart);
+
+                // Coalesce in place
+                std::size_t n = 0;
+
+                for (std::size_t i = 0; i < x.size(); i++)
+                {
+                    if (n && x[n-1].end >= x[i].start)
+                    {
+                        x[n-1].end = std::max(x[n-1].end, x[i].end);
+                    }
+                    else
+                    {
+                        x[n++] = x[i];
+                    }
+                }
+
+                x.resize(n);
+
+                _buf.clear();
+                _data.swap(x);
+            }
+
+            // Loci not yet coalesced
+            mutable std::vector<Locus> _buf;
+
+            // Coalesced loci
+            mutable std::vector<Locus> _data;
+    };
+}
+
+#endif
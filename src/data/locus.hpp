@@ -4,23 +4,31 @@
 #include <string>
 #include <vector>
 #include <assert.h>
+#include <stdexcept>
+#include <type_traits>
 #include <algorithm>
+#include <functional>
 #include "data/data.hpp"
 
 namespace Anaquin
 {
+    /*
+     * Closed interval [start, end] on a chromosome. This is created for every alignment block, so it
+     * holds nothing but the coordinates (16 bytes, trivially copyable). Anything that needs a name
+     * should pair the locus with an ID (eg: Interval).
+     */
+    
     class Locus
     {
         public:
 
-            Locus(const Locus &l1, const Locus &l2, const std::string &key = "") : _key(key)
+            Locus(const Locus &l1, const Locus &l2)
             {
                 end   = std::max(l1.end,   l2.end);
                 start = std::min(l1.start, l2.start);
             }
 
-            Locus(Base start = 0, Base end = 0, const std::string &key = "")
-                    : start(start), end(end), _key(key)
+            Locus(Base start = 0, Base end = 0) : start(start), end(end)
             {
                 if (end < start)
                 {
@@ -28,9 +36,10 @@ namespace Anaquin
                 }
             }
 
+            // Default name for the locus, eg: "100_200"
             inline std::string key() const
             {
-                return !_key.empty() ? _key : std::to_string(start) + "_" + std::to_string(end);
+                return std::to_string(start) + "_" + std::to_string(end);
             }
 
             /*
@@ -91,8 +100,6 @@ namespace Anaquin
                 start = std::min(start, l.start);
             }
 
-            inline void add(const std::string &key) { _key = key; }
-
             inline Base length() const { return (end - start + 1); }
 
             inline Base overlap(const Locus &l) const
@@ -147,9 +154,21 @@ namespace Anaquin
             }
 
             Base start, end;
+    };
+
+    static_assert(sizeof(Locus) == 2 * sizeof(Base), "Locus must only hold the coordinates");
+    static_assert(std::is_trivially_copyable<Locus>::value, "Locus must be trivially copyable");
+}
 
-        private:
-            std::string _key;
+namespace std
+{
+    template <> struct hash<Anaquin::Locus>
+    {
+        inline std::size_t operator()(const Anaquin::Locus &l) const
+        {
+            const auto h = std::hash<Anaquin::Base>();
+            return h(l.start) ^ (h(l.end) + 0x9e3779b97f4a7c15ULL + (h(l.start) << 6) + (h(l.start) >> 2));
+        }
     };
 }
 
@@ -4,6 +4,7 @@
 #include <set>
 #include <map>
 #include <cmath>
+#include <vector>
 #include <numeric>
 #include "data/data.hpp"
 #include "data/itree.hpp"
@@ -69,6 +70,9 @@ namespace Anaquin
 
             inline const std::string &gID() const { return _gID; }
             inline const std::string &tID() const { return _tID; }
+
+            // Dense index of the interval within MergedIntervals (only after build)
+            inline Counts ordinal() const { return _i; }
         
             inline IntervalID name() const override { return id(); }
         
@@ -84,6 +88,8 @@ namespace Anaquin
         
             Locus _l;
 
+            Counts _i = 0;
+
             std::map<Base, Locus> _data;
         
             GeneID  _gID;
@@ -112,33 +118,19 @@ namespace Anaquin
                 _inters.insert(typename std::map<typename T::IntervalID, T>::value_type(i.id(), i));
             }
 
-            /*
-             * Merge the new interval with the first existing overlapping interval. New interval is
-             * added if no overlapping found.
-             */
-            
-            inline void merge(const T &i)
-            {
-                for (auto &j : _inters)
-                {
-                    if (j.second.l().overlap(i.l()))
-                    {
-                        j.second.merge(i.l());
-                        return;
-                    }
-                }
-
-                add(i);
-            }
-        
             inline void build()
             {
                 std::vector<Interval_<T *>> loci;
             
                 #define LOCUS_TO_TINTERVAL(x) Interval_<T *>(x.l().start, x.l().end, &x)
             
+                Counts n = 0;
+
                 for (auto &i : _inters)
                 {
+                    // Ordinals follow the order of the IDs
+                    i.second._i = n++;
+                    
                     loci.push_back(LOCUS_TO_TINTERVAL(i.second));
                 }
                 
@@ -276,6 +268,46 @@ namespace Anaquin
             IntervalData _inters;
     };
 
+    /*
+     * Counters for the intervals in MergedIntervals, indexed by the ordinals of the intervals. Counters
+     * accumulated separately (eg: for each thread) are merged by adding them.
+     */
+    
+    template <typename T = Counts> class OrdinalCounts
+    {
+        public:
+        
+            OrdinalCounts() {}
+            OrdinalCounts(std::size_t n) : _data(n) {}
+        
+            template <typename I> OrdinalCounts(const MergedIntervals<I> &x) : _data(x.size()) {}
+
+            inline T &operator[](const MergedInterval &i) { return _data[i.ordinal()]; }
+        
+            inline T operator[](const MergedInterval &i) const
+            {
+                return static_cast<std::size_t>(i.ordinal()) < _data.size() ? _data[i.ordinal()] : 0;
+            }
+        
+            inline OrdinalCounts &operator+=(const OrdinalCounts &x)
+            {
+                A_CHECK(_data.size() == x._data.size(), "Counters for different intervals");
+                
+                for (std::size_t i = 0; i < _data.size(); i++)
+                {
+                    _data[i] += x._data[i];
+                }
+                
+                return *this;
+            }
+
+            inline std::size_t size() const { return _data.size(); }
+        
+        private:
+        
+            std::vector<T> _data;
+    };
+    
     typedef std::map<ChrID, MergedIntervals<>> MC2Intervals;
 }
 
@@ -1,32 +1,765 @@
-#include <fstream>
-#include <sstream>
-#include <iostream>
-#include <assert.h>
+#include <mutex>
+#include <fcntl.h>
+#include <zlib.h>
+#include <cctype>
+#include <cerrno>
+#include <thread>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <unistd.h>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <condition_variable>
 #include "data/reader.hpp"
 #include <boost/algorithm/string.hpp>
 
 using namespace Anaquin;
 
+// Size of the reads for files that can't be mapped (eg: pipes)
+static const std::size_t ChunkSize = 1 << 20;
+
+// Largest block in a BGZF file, compressed or not
+static const std::size_t BGZFBlock = 1 << 16;
+
+namespace
+{
+    enum class Compression
+    {
+        None,
+        GZip,
+        BGZF,
+        Zstd,
+    };
+
+    // Compression of a file by the magic bytes at the start
+    Compression compression(const char *p, std::size_t n)
+    {
+        const auto u = reinterpret_cast<const unsigned char *>(p);
+
+        if (n >= 4 && u[0] == 0x28 && u[1] == 0xb5 && u[2] == 0x2f && u[3] == 0xfd)
+        {
+            return Compression::Zstd;
+        }
+        else if (n < 2 || u[0] != 0x1f || u[1] != 0x8b)
+        {
+            return Compression::None;
+        }
+
+        // BGZF has a "BC" subfield for the size of the block (same check as htslib)
+        return n >= 16 && (u[3] & 4) && u[12] == 'B' && u[13] == 'C' ? Compression::BGZF : Compression::GZip;
+    }
+
+    ssize_t readFD(int fd, char *p, std::size_t n)
+    {
+        ssize_t r;
+        while ((r = read(fd, p, n)) < 0 && errno == EINTR) {}
+        return r;
+    }
+
+    /*
+     * Decompresses a gzip file as a stream. Members are decompressed one after another, so this also
+     * works for BGZF and concatenated files. The compressed data is either in memory or read from a
+     * file (eg: a pipe).
+     */
+
+    class GZip
+    {
+        public:
+
+            GZip(const char *data, std::size_t size) : _data(data), _size(size)
+            {
+                init();
+            }
+
+            // The first bytes have already been read from the file
+            GZip(int fd, std::vector<char> first) : _fd(fd), _in(std::move(first))
+            {
+                init();
+
+                _z.next_in  = reinterpret_cast<Bytef *>(_in.data());
+                _z.avail_in = static_cast<uInt>(_in.size());
+            }
+
+            ~GZip()
+            {
+                inflateEnd(&_z);
+            }
+
+            GZip(const GZip &) = delete;
+            GZip &operator=(const GZip &) = delete;
+
+            // Decompress up to n bytes, zero at the end
+            std::size_t read(char *p, std::size_t n)
+            {
+                n = std::min<std::size_t>(n, UINT_MAX);
+
+                _z.next_out  = reinterpret_cast<Bytef *>(p);
+                _z.avail_out = static_cast<uInt>(n);
+
+                while (_z.avail_out == n)
+                {
+                    if (!_z.avail_in && !more())
+                    {
+                        if (_member)
+                        {
+                            throw std::runtime_error("Failed to decompress, the file is truncated.");
+                        }
+
+                        break;
+                    }
+
+                    const auto r = inflate(&_z, Z_NO_FLUSH);
+
+                    if (r == Z_STREAM_END)
+                    {
+                        // Another member might follow
+                        inflateReset(&_z);
+                        _member = false;
+                    }
+                    else if (r == Z_OK)
+                    {
+                        _member = true;
+                    }
+                    else
+                    {
+                        throw std::runtime_error(std::string("Failed to decompress: ") + (_z.msg ? _z.msg : "invalid data"));
+                    }
+                }
+
+                return n - _z.avail_out;
+            }
+
+            // Back to the start, only possible for data in memory
+            bool reset()
+            {
+                if (_fd >= 0)
+                {
+                    return false;
+                }
+
+                inflateReset(&_z);
+
+                _z.avail_in = 0;
+                _off = 0;
+                _member = false;
+
+                return true;
+            }
+
+        private:
+
+            void init()
+            {
+                std::memset(&_z, 0, sizeof(_z));
+
+                // Only gzip, not zlib
+                if (inflateInit2(&_z, 16 + MAX_WBITS) != Z_OK)
+                {
+                    throw std::runtime_error("Failed to initialize zlib");
+                }
+            }
+
+            // More compressed data, false if there's none
+            bool more()
+            {
+                if (_fd >= 0)
+                {
+                    _in.resize(ChunkSize);
+
+                    const auto n = readFD(_fd, _in.data(), _in.size());
+
+                    if (n <= 0)
+                    {
+                        return false;
+                    }
+
+                    _z.next_in  = reinterpret_cast<Bytef *>(_in.data());
+                    _z.avail_in = static_cast<uInt>(n);
+                }
+                else
+                {
+                    if (_off >= _size)
+                    {
+                        return false;
+                    }
+
+                    const auto n = std::min<std::size_t>(_size - _off, 1 << 30);
+
+                    _z.next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(_data + _off));
+                    _z.avail_in = static_cast<uInt>(n);
+
+                    _off += n;
+                }
+
+                return true;
+            }
+
+            z_stream _z;
+
+            // Compressed data in memory
+            const char *_data = nullptr;
+            std::size_t _size = 0, _off = 0;
+
+            // Compressed data from a file
+            int _fd = -1;
+            std::vector<char> _in;
+
+            // In the middle of a member?
+            bool _member = false;
+    };
+
+    /*
+     * BGZF blocks are independent gzip members, so the threads decompress the blocks ahead of the
+     * reader. The blocks are given out in the same order as the file.
+     */
+
+    class BGZF
+    {
+        public:
+
+            BGZF(const char *data, std::size_t size, unsigned threads, const std::string &file)
+                : _data(data), _size(size), _threads(threads), _blocks(4 * threads), _file(file) {}
+
+            ~BGZF()
+            {
+                stop();
+            }
+
+            BGZF(const BGZF &) = delete;
+            BGZF &operator=(const BGZF &) = delete;
+
+            // Copy up to n decompressed bytes, zero at the end
+            std::size_t read(char *p, std::size_t n)
+            {
+                if (_ts.empty())
+                {
+                    start();
+                }
+
+                std::size_t k = 0;
+
+                while (k < n)
+                {
+                    auto &b = _blocks[_used % _blocks.size()];
+
+                    {
+                        std::unique_lock<std::mutex> l(_lock);
+                        _cv.wait(l, [&]() { return b.done || end(); });
+
+                        if (!b.done)
+                        {
+                            break;
+                        }
+                        else if (!b.error.empty())
+                        {
+                            throw std::runtime_error("File: " + _file + ". " + b.error);
+                        }
+                    }
+
+                    const auto m = std::min(n - k, b.len - _pos);
+
+                    std::memcpy(p + k, b.out.data() + _pos, m);
+
+                    k    += m;
+                    _pos += m;
+
+                    // Give the block back to the threads
+                    if (_pos == b.len)
+                    {
+                        {
+                            std::lock_guard<std::mutex> l(_lock);
+
+                            b.done = false;
+                            _used++;
+                            _pos = 0;
+                        }
+
+                        _cv.notify_all();
+                    }
+                }
+
+                return k;
+            }
+
+            void reset()
+            {
+                stop();
+
+                for (auto &b : _blocks)
+                {
+                    b.done = false;
+                    b.error.clear();
+                }
+
+                _off = _next = _used = _pos = 0;
+                _n = npos;
+            }
+
+        private:
+
+            static const std::size_t npos = static_cast<std::size_t>(-1);
+
+            struct Block
+            {
+                std::vector<char> out;
+
+                // Size after decompression
+                std::size_t len = 0;
+
+                bool done = false;
+
+                // Empty unless the block is invalid
+                std::string error;
+            };
+
+            // Everything has been read? (must hold the lock)
+            inline bool end() const
+            {
+                return _n != npos && _used >= _n;
+            }
+
+            // Size of the block at the offset from its header, zero if it's not a BGZF block
+            std::size_t blockSize(std::size_t off) const
+            {
+                const auto u = reinterpret_cast<const unsigned char *>(_data + off);
+                const auto n = _size - off;
+
+                if (n < 18 || u[0] != 0x1f || u[1] != 0x8b || u[2] != 8 || !(u[3] & 4))
+                {
+                    return 0;
+                }
+
+                const std::size_t xlen = u[10] | (u[11] << 8);
+
+                for (std::size_t i = 12; i + 4 <= 12 + xlen && i + 4 <= n;)
+                {
+                    const std::size_t slen = u[i+2] | (u[i+3] << 8);
+
+                    if (u[i] == 'B' && u[i+1] == 'C' && slen == 2 && i + 6 <= n)
+                    {
+                        const std::size_t size = (u[i+4] | (u[i+5] << 8)) + 1;
+                        return size <= n && size >= 12 + xlen + 8 ? size : 0;
+                    }
+
+                    i += 4 + slen;
+                }
+
+                return 0;
+            }
+
+            void start()
+            {
+                for (auto i = 0u; i < _threads; i++)
+                {
+                    _ts.push_back(std::thread([&]() { work(); }));
+                }
+            }
+
+            void stop()
+            {
+                {
+                    std::lock_guard<std::mutex> l(_lock);
+                    _stop = true;
+                }
+
+                _cv.notify_all();
+
+                for (auto &t : _ts)
+                {
+                    t.join();
+                }
+
+                _ts.clear();
+                _stop = false;
+            }
+
+            void work()
+            {
+                z_stream z;
+                std::memset(&z, 0, sizeof(z));
+
+                // Raw deflate, the header is read here
+                inflateInit2(&z, -MAX_WBITS);
+
+                for (;;)
+                {
+                    std::size_t i, off, size;
+
+                    {
+                        std::unique_lock<std::mutex> l(_lock);
+                        _cv.wait(l, [&]() { return _stop || _n != npos || _next < _used + _blocks.size(); });
+
+                        if (_stop || _n != npos)
+                        {
+                            break;
+                        }
+
+                        i    = _next++;
+                        off  = _off;
+                        size = blockSize(off);
+
+                        // Nothing is decompressed after an invalid block
+                        _off = size ? _off + size : _size;
+
+                        if (_off >= _size)
+                        {
+                            _n = _next;
+                        }
+                    }
+
+                    auto &b = _blocks[i % _blocks.size()];
+
+                    b.len = 0;
+                    b.out.resize(BGZFBlock);
+
+                    if (!size)
+                    {
+                        b.error = "Invalid BGZF block at " + std::to_string(off);
+                    }
+                    else
+                    {
+                        const auto u = reinterpret_cast<const unsigned char *>(_data + off);
+                        const std::size_t xlen = u[10] | (u[11] << 8);
+
+                        // Size after decompression is in the last four bytes
+                        const auto e = u + size - 4;
+                        const std::size_t len = e[0] | (e[1] << 8) | (e[2] << 16) | (static_cast<std::size_t>(e[3]) << 24);
+
+                        inflateReset(&z);
+
+                        z.next_in   = const_cast<Bytef *>(u + 12 + xlen);
+                        z.avail_in  = static_cast<uInt>(size - 12 - xlen - 8);
+                        z.next_out  = reinterpret_cast<Bytef *>(b.out.data());
+                        z.avail_out = static_cast<uInt>(std::min(len, BGZFBlock));
+
+                        if (len > BGZFBlock || inflate(&z, Z_FINISH) != Z_STREAM_END || z.total_out != len)
+                        {
+                            b.error = "Failed to decompress the BGZF block at " + std::to_string(off);
+                        }
+                        else
+                        {
+                            b.len = len;
+                        }
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> l(_lock);
+                        b.done = true;
+                    }
+
+                    _cv.notify_all();
+                }
+
+                inflateEnd(&z);
+            }
+
+            const char *_data;
+            const std::size_t _size;
+            const unsigned _threads;
+
+            // Decompressed blocks, block i is at i % size
+            std::vector<Block> _blocks;
+
+            // Offset of the next block for the threads
+            std::size_t _off = 0;
+
+            // Blocks taken by the threads, the block being read and the number of blocks (once known)
+            std::size_t _next = 0, _used = 0, _n = npos;
+
+            // Position in the block being read
+            std::size_t _pos = 0;
+
+            bool _stop = false;
+
+            std::mutex _lock;
+            std::condition_variable _cv;
+            std::vector<std::thread> _ts;
+
+            const std::string _file;
+    };
+
+    /*
+     * Text of a reader, shared by its copies (including the position). Regular files are mapped,
+     * anything else (eg: a pipe) is read in chunks. Compressed files (gzip or BGZF) are decompressed
+     * in chunks. Lines are views into the text.
+     */
+
+    struct Source
+    {
+        // Memory input
+        struct FromString {};
+
+        // The text is owned
+        Source(FromString, const std::string &s) : str(s)
+        {
+            data = str.data();
+            size = str.size();
+        }
+
+        // File input, throws if it can't be read or it's empty
+        explicit Source(const std::string &file)
+        {
+            if ((fd = open(file.c_str(), O_RDONLY)) < 0)
+            {
+                throw InvalidFileError(file);
+            }
+
+            struct stat s;
+
+            if (!fstat(fd, &s) && S_ISREG(s.st_mode) && s.st_size > 0)
+            {
+                const auto m = mmap(nullptr, s.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+                if (m != MAP_FAILED)
+                {
+                    // Parsers read from the start to the end
+                    madvise(m, s.st_size, MADV_SEQUENTIAL);
+
+                    map = static_cast<const char *>(m);
+                    mapSize = s.st_size;
+
+                    close(fd);
+                    fd = -1;
+
+                    switch (compression(map, mapSize))
+                    {
+                        case Compression::None:
+                        {
+                            data = map;
+                            size = mapSize;
+                            return;
+                        }
+
+                        case Compression::Zstd:
+                        {
+                            throw std::runtime_error("File: " + file + ". Zstandard compression is not supported, please decompress the file.");
+                        }
+
+                        case Compression::BGZF:
+                        {
+                            bgzf.reset(new BGZF(map, mapSize, std::max(1u, std::thread::hardware_concurrency()), file));
+                            break;
+                        }
+
+                        case Compression::GZip:
+                        {
+                            gzip.reset(new GZip(map, mapSize));
+                            break;
+                        }
+                    }
+                }
+            }
+
+            // Not a regular file or failed to map, so it's read in chunks
+            buf.resize(ChunkSize);
+
+            if (fd >= 0)
+            {
+                const auto n = readFD(fd, buf.data(), buf.size());
+
+                if (n <= 0)
+                {
+                    close(fd);
+                    throw InvalidFileError(file);
+                }
+
+                switch (compression(buf.data(), n))
+                {
+                    case Compression::None:
+                    {
+                        data = buf.data();
+                        size = n;
+                        return;
+                    }
+
+                    case Compression::Zstd:
+                    {
+                        close(fd);
+                        throw std::runtime_error("File: " + file + ". Zstandard compression is not supported, please decompress the file.");
+                    }
+
+                    default:
+                    {
+                        gzip.reset(new GZip(fd, std::vector<char>(buf.begin(), buf.begin() + n)));
+                        break;
+                    }
+                }
+            }
+
+            // Nothing after decompression
+            if (!fill())
+            {
+                throw InvalidFileError(file);
+            }
+        }
+
+        ~Source()
+        {
+            // The threads must be stopped before the data is unmapped
+            bgzf.reset();
+
+            if (map)
+            {
+                munmap(const_cast<char *>(map), mapSize);
+            }
+
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+
+        inline bool isCompressed() const
+        {
+            return gzip || bgzf;
+        }
+
+        // Memory and mapped files can always go back, a pipe (or anything inflated from one) can't
+        inline bool canReset() const
+        {
+            return fd < 0 || (!gzip && lseek(fd, 0, SEEK_CUR) >= 0);
+        }
+
+        // Read more text after the unread part, false if there's nothing more
+        bool fill()
+        {
+            if (eof || (fd < 0 && !isCompressed()))
+            {
+                return false;
+            }
+
+            // Keep the unread part, a line longer than the buffer makes it grow
+            const auto left = size - pos;
+
+            std::memmove(&buf[0], &buf[pos], left);
+
+            if (left == buf.size())
+            {
+                buf.resize(2 * buf.size());
+            }
+
+            pos  = 0;
+            size = left;
+
+            ssize_t n;
+
+            if (bgzf)
+            {
+                n = bgzf->read(&buf[size], buf.size() - size);
+            }
+            else if (gzip)
+            {
+                n = gzip->read(&buf[size], buf.size() - size);
+            }
+            else
+            {
+                n = readFD(fd, &buf[size], buf.size() - size);
+            }
+
+            if (n <= 0)
+            {
+                eof = true;
+                return false;
+            }
+
+            size += n;
+            data  = buf.data();
+
+            return true;
+        }
+
+        // Next line without the new line, false if there's nothing more
+        bool next(boost::string_ref &x)
+        {
+            for (;;)
+            {
+                const auto p = static_cast<const char *>(std::memchr(data + pos, '\n', size - pos));
+
+                if (p)
+                {
+                    x = boost::string_ref(data + pos, p - (data + pos));
+                    pos = p - data + 1;
+                    return true;
+                }
+
+                // No new line for the last line, a chunk might have stopped in the middle of a line
+                else if (!fill())
+                {
+                    if (pos < size)
+                    {
+                        x = boost::string_ref(data + pos, size - pos);
+                        pos = size;
+                        return true;
+                    }
+
+                    return false;
+                }
+            }
+        }
+
+        // Back to the start, only possible for memory and files that can be seeked
+        void reset()
+        {
+            if (bgzf)
+            {
+                bgzf->reset();
+            }
+            else if (gzip && !gzip->reset())
+            {
+                return;
+            }
+            else if (!gzip && fd >= 0 && lseek(fd, 0, SEEK_SET) != 0)
+            {
+                return;
+            }
+
+            if (isCompressed() || fd >= 0)
+            {
+                eof  = false;
+                size = 0;
+            }
+
+            pos = 0;
+        }
+
+        std::string str;
+
+        // Text not yet read is [data + pos, data + size)
+        const char *data = nullptr;
+        std::size_t size = 0, pos = 0;
+
+        // Mapped file, might be compressed
+        const char *map = nullptr;
+        std::size_t mapSize = 0;
+
+        // Only for files read in chunks
+        int fd = -1;
+        bool eof = false;
+        std::vector<char> buf;
+
+        // Only for compressed files
+        std::unique_ptr<GZip> gzip;
+        std::unique_ptr<BGZF> bgzf;
+    };
+}
+
 struct Anaquin::ReaderInternal
 {
     Line line;
-    
+
     // Defined only for file input
     std::string file;
-    
-    // Implementation for file
-    std::shared_ptr<std::ifstream> f;
 
-    // Implementation for memory
-    std::shared_ptr<std::stringstream> s;
+    bool isFile = false;
+
+    std::shared_ptr<Source> src;
 };
 
 Reader::Reader(const Reader &r)
 {
-    _imp = new ReaderInternal();
-    _imp->line = r._imp->line;
-    _imp->f = r._imp->f;
-    _imp->s = r._imp->s;
+    _imp = new ReaderInternal(*r._imp);
 
     // Make sure we start off from the default state
     reset();
@@ -38,33 +771,18 @@ Reader::Reader(const std::string &file, DataMode mode)
     {
         throw std::runtime_error("Empty file name");
     }
-    
+
     _imp = new ReaderInternal();
     _imp->file = file;
 
     if (mode == DataMode::File)
     {
-        const auto f = std::shared_ptr<std::ifstream>(new std::ifstream(file));
-
-        if (!f->good())
-        {
-            throw InvalidFileError(file);
-        }
-        else if (f->peek() == std::ifstream::traits_type::eof())
-        {
-            throw InvalidFileError(file);
-        }
-
-        _imp->f = f;
+        _imp->isFile = true;
+        _imp->src = std::make_shared<Source>(file);
     }
     else
     {
-        if (file.empty())
-        {
-            throw InvalidFileError(file);
-        }
-
-        _imp->s = std::shared_ptr<std::stringstream>(new std::stringstream(file));
+        _imp->src = std::make_shared<Source>(Source::FromString(), file);
     }
 }
 
@@ -80,17 +798,7 @@ Line Reader::lastLine() const
 
 void Reader::reset()
 {
-    if (_imp->f)
-    {
-        _imp->f->clear();
-        _imp->f->seekg(0, std::ios::beg);
-    }
-    
-    if (_imp->s)
-    {
-        _imp->s->clear();
-        _imp->s->seekg(0, std::ios::beg);
-    }
+    _imp->src->reset();
 }
 
 std::string Reader::src() const
@@ -98,24 +806,82 @@ std::string Reader::src() const
     return _imp->file;
 }
 
-bool Reader::nextLine(std::string &line) const
+bool Reader::isFile() const
 {
-    retry:
+    return _imp->isFile;
+}
+
+bool Reader::isCompressed() const
+{
+    return _imp->src->isCompressed();
+}
+
+bool Reader::canReset() const
+{
+    return _imp->src->canReset();
+}
 
-    if ((_imp->f && std::getline(*_imp->f, line)) || (_imp->s && std::getline(*_imp->s, line)))
+std::uint64_t Reader::hash() const
+{
+    auto &s = *_imp->src;
+
+    // Hashing reads everything, there'd be nothing left to parse
+    if (!s.canReset())
+    {
+        throw std::runtime_error("Unable to hash " + _imp->file + ". The input can't be read twice (eg: a pipe).");
+    }
+
+    s.reset();
+
+    // FNV-1a
+    std::uint64_t h = 14695981039346656037ULL;
+
+    do
     {
-        if (line.empty())
+        for (auto i = s.pos; i < s.size; i++)
         {
-            goto retry;
+            h = (h ^ static_cast<unsigned char>(s.data[i])) * 1099511628211ULL;
         }
 
-        boost::trim(line);
-        return true;
+        s.pos = s.size;
     }
-    else
+    while (s.fill());
+
+    s.reset();
+
+    return h;
+}
+
+bool Reader::nextView(boost::string_ref &x) const
+{
+    // Same as std::getline(), an empty line is skipped before it's trimmed
+    do
     {
-        return false;
+        if (!_imp->src->next(x))
+        {
+            return false;
+        }
+    }
+    while (x.empty());
+
+    // Same as boost::trim()
+    while (!x.empty() && std::isspace(static_cast<unsigned char>(x.front()))) { x.remove_prefix(1); }
+    while (!x.empty() && std::isspace(static_cast<unsigned char>(x.back())))  { x.remove_suffix(1); }
+
+    return true;
+}
+
+bool Reader::nextLine(std::string &line) const
+{
+    boost::string_ref x;
+
+    if (nextView(x))
+    {
+        line.assign(x.data(), x.size());
+        return true;
     }
+
+    return false;
 }
 
 bool Reader::nextTokens(std::vector<std::string> &toks, const std::string &c) const
@@ -132,4 +898,4 @@ bool Reader::nextTokens(std::vector<std::string> &toks, const std::string &c) co
     {
         return false;
     }
-}
\ No newline at end of file
+}
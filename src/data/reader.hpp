@@ -2,9 +2,11 @@
 #define READER_HPP
 
 #include <vector>
+#include <cstdint>
 #include <string>
 #include <ostream>
 #include "parsers/parser.hpp"
+#include <boost/utility/string_ref.hpp>
 
 namespace Anaquin
 {
@@ -18,7 +20,8 @@ namespace Anaquin
     
     /*
      * Reader encapsulates the underlying data source. For example, we could source from a memory string
-     * or a physical file.
+     * or a physical file. Regular files are memory-mapped, other files (eg: pipes) are read in chunks.
+     * Files compressed by gzip or BGZF are detected by their magic bytes and decompressed transparently.
      */
 
     class Reader
@@ -33,10 +36,29 @@ namespace Anaquin
         
             // Returns description for the source
             std::string src() const;
+
+            // Is the source a physical file?
+            bool isFile() const;
+
+            // Is the file compressed? (positions in the file aren't positions in the text)
+            bool isCompressed() const;
+
+            // Can the reader go back to the start? Not for pipes
+            bool canReset() const;
+
+            // Returns a hash of the entire content (the reader is reset), only if canReset()
+            std::uint64_t hash() const;
         
             // Returns the next line in the file
             bool nextLine(std::string &) const;
 
+            /*
+             * Same as nextLine() but without copying, the view points into the reader's buffer and is
+             * only valid until the next read.
+             */
+
+            bool nextView(boost::string_ref &) const;
+
             // Returns the next line and parse it into tokens
             bool nextTokens(std::vector<std::string> &, const std::string &c) const;
 
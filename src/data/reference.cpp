@@ -1,7 +1,11 @@
+#include <thread>
+#include <unordered_map>
 #include "data/tokens.hpp"
+#include "data/snapshot.hpp"
 #include "tools/bed_data.hpp"
 #include "tools/gtf_data.hpp"
-#include "tools/vcf_data.hpp"
+#include "tools/gtf_index.hpp"
+#include "tools/vcf_columns.hpp"
 #include "data/reference.hpp"
 #include "VarQuin/VarQuin.hpp"
 #include "RnaQuin/RnaQuin.hpp"
@@ -10,11 +14,11 @@
 
 using namespace Anaquin;
 
-template <typename Key, typename Value> std::set<Key> getKeys(const std::map<Key, Value> &m)
+template <typename Key, typename Value, typename C, typename A> std::set<Key> getKeys(const std::map<Key, Value, C, A> &m)
 {
     std::set<Key> keys;
 
-    for(auto i: m)
+    for (const auto &i : m)
     {
         keys.insert(i.first);
     }
@@ -22,6 +26,12 @@ template <typename Key, typename Value> std::set<Key> getKeys(const std::map<Key
     return keys;
 }
 
+// The regions kept depend on __hackBedFile__, so are the snapshots
+static BedData cachedBed(const Reader &r)
+{
+    return Snapshot::cached<BedData>(r, __hackBedFile__ ? "bed-all" : "bed", bedData);
+}
+
 /*
  * ------------------------- Transcriptome Analysis -------------------------
  */
@@ -45,10 +55,63 @@ struct RnaRef::RnaRefImpl
     
     // Intervals for the genes
     std::map<ChrID, Intervals<>> gInters;
+
+    // Chromosomes to load, empty for everything
+    std::set<ChrID> only;
+
+    // Totals for the genomic chromosomes not loaded
+    std::map<ChrID, GTFTotals> skipped;
+
+    /*
+     * Expected concentrations and log-folds, sequins are numbered in the order they're added. NAN
+     * if not available (eg: only a single mixture). Built by validate().
+     */
+
+    struct Table
+    {
+        inline void add(const SequinID &id)
+        {
+            if (ords.insert(std::make_pair(id, ords.size())).second)
+            {
+                c1.push_back(0);
+                c2.push_back(0);
+            }
+        }
+
+        inline Concent concent(std::size_t i, Mixture mix) const
+        {
+            return mix == Mix_1 ? c1[i] : c2[i];
+        }
+
+        // Ordinals for the sequins
+        std::unordered_map<SequinID, std::size_t> ords;
+
+        // Concentration for each mixture
+        std::vector<Concent> c1, c2;
+
+        // Eg: log2(c2 / c1)
+        std::vector<LogFold> lfs;
+    };
+
+    // Genes and isoforms for the sequins
+    Table genes, isos;
 };
 
 RnaRef::RnaRef() : _impl(new RnaRefImpl()) {}
 
+// Sum a total over the chromosomes not loaded
+template <typename T> T countSkipped(const std::map<ChrID, GTFTotals> &x, T GTFTotals::*p)
+{
+    T n = 0;
+    
+    for (const auto &i : x)
+    {
+        n += i.second.*p;
+    }
+    
+    return n;
+}
+
 Counts RnaRef::countLenSyn() const
 {
     return _impl->gData.countLenSyn();
@@ -56,7 +119,7 @@ Counts RnaRef::countLenSyn() const
 
 Counts RnaRef::countLenGen() const
 {
-    return _impl->gData.countLenGen();
+    return _impl->gData.countLenGen() + countSkipped(_impl->skipped, &GTFTotals::gLen);
 }
 
 Counts RnaRef::countUExon(const ChrID &cID) const
@@ -71,7 +134,7 @@ Counts RnaRef::countUExonSyn() const
 
 Counts RnaRef::countUExonGen() const
 {
-    return _impl->gData.countUExonGen();
+    return _impl->gData.countUExonGen() + countSkipped(_impl->skipped, &GTFTotals::uexons);
 }
 
 Counts RnaRef::countUIntr(const ChrID &cID) const
@@ -86,7 +149,7 @@ Counts RnaRef::countUIntrSyn() const
 
 Counts RnaRef::countUIntrGen() const
 {
-    return _impl->gData.countUIntrGen();
+    return _impl->gData.countUIntrGen() + countSkipped(_impl->skipped, &GTFTotals::uintrs);
 }
 
 Counts RnaRef::nGeneSyn() const
@@ -96,7 +159,7 @@ Counts RnaRef::nGeneSyn() const
 
 Counts RnaRef::nGeneGen() const
 {
-    return _impl->gData.nGeneGen();
+    return _impl->gData.nGeneGen() + countSkipped(_impl->skipped, &GTFTotals::genes);
 }
 
 Counts RnaRef::countTransSyn() const
@@ -106,12 +169,58 @@ Counts RnaRef::countTransSyn() const
 
 Counts RnaRef::countTransGen() const
 {
-    return _impl->gData.countTransGen();
+    return _impl->gData.countTransGen() + countSkipped(_impl->skipped, &GTFTotals::trans);
+}
+
+const std::map<ChrID, GTFTotals> &RnaRef::skipped() const
+{
+    return _impl->skipped;
+}
+
+void RnaRef::loadOnly(const std::set<ChrID> &cIDs)
+{
+    _impl->only = cIDs;
 }
 
 void RnaRef::readRef(const Reader &r)
 {
-    for (const auto &i : (_impl->gData = gtfData(r)))
+    // The index has offsets in the file, that's only possible without compression
+    if (_impl->only.empty() || !r.isFile() || r.isCompressed())
+    {
+        _impl->gData = Snapshot::cached<GTFData>(r, "gtf", [&](const Reader &r)
+        {
+            return gtfData(r, std::thread::hardware_concurrency());
+        });
+    }
+    else
+    {
+        // Seek to the chromosomes wanted rather than parsing the whole annotation
+        const auto x = Snapshot::cached<GTFIndex>(r, "gtf-index", gtfIndex);
+
+        auto cIDs = _impl->only;
+
+        for (const auto &i : x)
+        {
+            if (isRnaQuin(i.first))
+            {
+                cIDs.insert(i.first);
+            }
+        }
+
+        _impl->gData = gtfData(r, x, cIDs);
+
+        // The chromosomes skipped still count in the reference
+        for (const auto &i : x.totals)
+        {
+            if (!cIDs.count(i.first))
+            {
+                _impl->skipped[i.first] = i.second;
+                Standard::addGenomic(i.first);
+            }
+        }
+    }
+
+    for (const auto &i : _impl->gData)
     {
         if (!isRnaQuin(i.first))
         {
@@ -144,6 +253,15 @@ Counts RnaRef::nGeneSeqs() const
 
 LogFold RnaRef::logFoldGene(const GeneID &gID) const
 {
+    const auto &x = _impl->genes;
+    const auto  i = x.ords.find(gID);
+
+    if (i != x.ords.end() && !isnan(x.lfs[i->second]))
+    {
+        return x.lfs[i->second];
+    }
+
+    // Not available, report why
     const auto e1 = concent(gID, Mix_1);
     const auto e2 = concent(gID, Mix_2);
 
@@ -152,11 +270,18 @@ LogFold RnaRef::logFoldGene(const GeneID &gID) const
 
 LogFold RnaRef::logFoldSeq(const IsoformID &iID) const
 {
+    const auto &x = _impl->isos;
+    const auto  i = x.ords.find(iID);
+
+    A_CHECK(i != x.ords.end(), "Sequin not found: " + iID);
+
+    if (!isnan(x.lfs[i->second]))
+    {
+        return x.lfs[i->second];
+    }
+
     const auto m = match(iID);
-    
-    // It's pre-condition that the sequin exists
-    assert(m);
-    
+
     const auto e1 = m->concent(Mix_1);
     const auto e2 = m->concent(Mix_2);
     
@@ -165,37 +290,31 @@ LogFold RnaRef::logFoldSeq(const IsoformID &iID) const
 
 Concent RnaRef::concent(const GeneID &gID, Mixture mix) const
 {
-    for (const auto &i : _impl->gData)
+    const auto &x = _impl->genes;
+    const auto  i = x.ords.find(gID);
+
+    if (i == x.ords.end())
     {
-        if (isRnaQuin(i.first))
+        if (x.ords.empty())
         {
-            A_CHECK(!i.second.t2g.empty(), "No transcript found in gene [" + gID + "]");
-
-            Concent r = 0;
+            A_THROW("Failed to find gene [" + gID + "]");
+        }
 
-            for (const auto &j : i.second.t2g)
-            {
-                // Does this transcript belong to the gene?
-                if (j.second == gID)
-                {
-                    // Add up the concentration
-                    r += match(j.first)->mixes.at(mix);
-                }
-            }
+        A_THROW("Concentration is zero for gene [" + gID + "]");
+    }
 
-            if (!r)
-            {
-                A_THROW("Concentration is zero for gene [" + gID + "]");
-            }
+    const auto r = x.concent(i->second, mix);
 
-            return r;
-        }
+    if (isnan(r))
+    {
+        throw std::out_of_range("No concentration for gene [" + gID + "]");
+    }
+    else if (!r)
+    {
+        A_THROW("Concentration is zero for gene [" + gID + "]");
     }
-    
-    A_THROW("Failed to find gene [" + gID + "]");
 
-    // Never executed
-    return Concent();
+    return r;
 }
 
 GeneID RnaRef::s2g(const SequinID &sID) const
@@ -411,6 +530,54 @@ void RnaRef::validate()
             _impl->gData[ChrIS].t2g[t.tID] = t.gID;
         }
     }
+
+    /*
+     * Tabulate the expected concentrations, so that they're not worked out for every query
+     */
+
+    auto &isos  = _impl->isos  = RnaRefImpl::Table();
+    auto &genes = _impl->genes = RnaRefImpl::Table();
+
+    auto mix = [&](const SequinData &x, Mixture m)
+    {
+        return x.mixes.count(m) ? x.mixes.at(m) : NAN;
+    };
+
+    for (const auto &i : _data)
+    {
+        isos.add(i.first);
+        isos.c1.back() = mix(i.second, Mix_1);
+        isos.c2.back() = mix(i.second, Mix_2);
+    }
+
+    for (const auto &i : _impl->gData)
+    {
+        if (isRnaQuin(i.first))
+        {
+            // Genes add up the transcripts
+            for (const auto &j : i.second.t2g)
+            {
+                genes.add(j.second);
+
+                const auto g = genes.ords.at(j.second);
+                const auto t = isos.ords.find(j.first);
+
+                genes.c1[g] += t != isos.ords.end() ? isos.c1[t->second] : NAN;
+                genes.c2[g] += t != isos.ords.end() ? isos.c2[t->second] : NAN;
+            }
+
+            break;
+        }
+    }
+
+    for (auto x : { &isos, &genes })
+    {
+        for (auto i = 0u; i < x->c1.size(); i++)
+        {
+            // Zero concentrations are left to the queries to report
+            x->lfs.push_back(x->c1[i] && x->c2[i] ? log2(x->c2[i] / x->c1[i]) : NAN);
+        }
+    }
 }
 
 /*
@@ -426,7 +593,7 @@ MetaRef::MetaRef() : _impl(new MetaRefImpl()) {}
 
 void MetaRef::readBed(const Reader &r)
 {
-    for (const auto &i : (_impl->bData = bedData(r)))
+    for (const auto &i : (_impl->bData = cachedBed(r)))
     {
         if (!isMetaQuin(i.first))
         {
@@ -508,7 +675,7 @@ struct VarRef::VarRefImpl
     // Mixture data
     std::map<Mixture, std::map<SequinID, VariantPair>> data;
 
-    VCFData vData;
+    VCFColumns vData;
     BedData bData;
 };
 
@@ -516,7 +683,7 @@ VarRef::VarRef() : _impl(new VarRefImpl()) {}
 
 void VarRef::readBRef(const Reader &r)
 {
-    for (const auto &i : (_impl->bData = bedData(r)))
+    for (const auto &i : (_impl->bData = cachedBed(r)))
     {
         if (!isVarQuin(i.first))
         {
@@ -527,7 +694,7 @@ void VarRef::readBRef(const Reader &r)
 
 void VarRef::readVRef(const Reader &r)
 {
-    for (const auto &i : (_impl->vData = vcfData(r)))
+    for (const auto &i : (_impl->vData = Snapshot::cached<VCFColumns>(r, "vcf-columns", vcfColumns)))
     {
         if (!isVarQuin(i.first))
         {
@@ -1,6 +1,7 @@
 #ifndef REFERENCE_HPP
 #define REFERENCE_HPP
 
+#include <unordered_map>
 #include "data/hist.hpp"
 #include "data/reader.hpp"
 #include "data/variant.hpp"
@@ -63,6 +64,30 @@ namespace Anaquin
     {
         public:
 
+            Reference() {}
+
+            // The indexes point into the sequins, they must be rebuilt for a copy
+            Reference(const Reference &x) : _data(x._data), _rawMIDs(x._rawMIDs), _mixes(x._mixes)
+            {
+                if (x._tree) { index(); }
+            }
+
+            inline Reference &operator=(const Reference &x)
+            {
+                _data    = x._data;
+                _mixes   = x._mixes;
+                _rawMIDs = x._rawMIDs;
+
+                _index.clear();
+                _tree.reset();
+
+                if (x._tree) { index(); }
+
+                return *this;
+            }
+
+            virtual ~Reference() {}
+
             // Add a sequin defined in a mixture file
             inline void add(const SequinID &id, Base length, Concent c, Mixture m)
             {
@@ -81,20 +106,45 @@ namespace Anaquin
 
             inline const Data *match(const SequinID &id) const
             {
-                return _data.count(id) ? &_data.at(id) : nullptr;
+                // Hashed after finalize()
+                if (_tree)
+                {
+                    const auto i = _index.find(id);
+                    return i != _index.end() ? i->second : nullptr;
+                }
+
+                const auto i = _data.find(id);
+                return i != _data.end() ? &i->second : nullptr;
             }
 
+            /*
+             * Sequin overlapping (or containing) the locus. If there're several, the one with the
+             * lowest ID is returned. Only available after finalize().
+             */
+        
             inline const Data *match(const Locus &l, MatchRule m) const
             {
-                for (const auto &i : _data)
+                assert(_tree);
+                
+                if (m != Overlap && m != Contains)
+                {
+                    return nullptr;
+                }
+
+                const auto x = m == Overlap ? _tree->findOverlapping(l.start, l.end)
+                                            : _tree->findContains(l.start, l.end);
+
+                const Data *r = nullptr;
+                
+                for (const auto &i : x)
                 {
-                    if ((m == Overlap && i.second.l.overlap(l)) || (m == Contains && i.second.l.contains(l)))
+                    if (!r || i.value->id < r->id)
                     {
-                        return &i.second;
+                        r = i.value;
                     }
                 }
 
-                return nullptr;
+                return r;
             }
         
             /*
@@ -140,6 +190,8 @@ namespace Anaquin
                         throw std::runtime_error("Validation failed. Zero length in data.");
                     }
                 }
+                
+                index();
             }
 
         protected:
@@ -250,15 +302,10 @@ namespace Anaquin
 
             inline const MixtureData * findMix(Mixture mix, const SequinID &id) const
             {
-                for (auto &i : _mixes.at(mix))
-                {
-                    if (i.id == id)
-                    {
-                        return &i;
-                    }
-                }
+                const auto &x = _mixes.at(mix);
+                const auto  i = x.find(MixtureData(id, 0, 0));
                 
-                return nullptr;
+                return i != x.end() ? &(*i) : nullptr;
             }
 
             // Validated sequins
@@ -269,6 +316,31 @@ namespace Anaquin
 
             // Data for mixture (if defined)
             std::map<Mixture, std::set<MixtureData>> _mixes;
+
+        private:
+
+            // Index the validated sequins by ID and by locus
+            inline void index()
+            {
+                std::vector<Interval_<const Data *>> x;
+
+                _index.clear();
+                _index.reserve(_data.size());
+
+                for (const auto &i : _data)
+                {
+                    _index[i.first] = &i.second;
+                    x.push_back(Interval_<const Data *>(i.second.l.start, i.second.l.end, &i.second));
+                }
+                
+                _tree = std::shared_ptr<IntervalTree<const Data *>>(new IntervalTree<const Data *> { x });
+            }
+
+            // Validated sequins by ID (built by finalize)
+            std::unordered_map<SequinID, const Data *> _index;
+
+            // Validated sequins by locus (built by finalize)
+            std::shared_ptr<IntervalTree<const Data *>> _tree;
     };
 
     /*
@@ -392,6 +464,7 @@ namespace Anaquin
     
     struct GeneData;
     struct TransData;
+    struct GTFTotals;
     
     class RnaRef : public Reference<SequinData, DefaultStats>
     {
@@ -399,6 +472,16 @@ namespace Anaquin
 
             RnaRef();
 
+            /*
+             * Only load these chromosomes (and the sequins) in readRef(), eg: chromosomes in the
+             * header of the alignments. Everything is loaded by default.
+             */
+
+            void loadOnly(const std::set<ChrID> &);
+
+            // Genomic chromosomes in the annotation but not loaded (see loadOnly()), counted in the totals
+            const std::map<ChrID, GTFTotals> &skipped() const;
+
             void readRef(const Reader &);
 
             std::map<ChrID, Hist> histGene() const;
@@ -0,0 +1,508 @@
+#include <fcntl.h>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "data/snapshot.hpp"
+#include "tools/bed_data.hpp"
+#include "tools/gtf_data.hpp"
+#include "tools/gtf_index.hpp"
+#include "tools/vcf_data.hpp"
+#include "tools/vcf_columns.hpp"
+#include <boost/format.hpp>
+
+using namespace Anaquin;
+
+std::string Snapshot::dir;
+
+// Eg: "ANQSNAP" and a null
+static const char Magic[8] = "ANQSNAP";
+
+namespace
+{
+    struct Header
+    {
+        char magic[8];
+
+        std::uint32_t version;
+
+        // Size of Base, to detect snapshots from incompatible builds
+        std::uint32_t base;
+
+        // Hash of the source
+        std::uint64_t hash;
+
+        // Size of the payload
+        std::uint64_t size;
+    };
+}
+
+/*
+ * ------------------------- Encoding -------------------------
+ */
+
+namespace
+{
+    struct Encoder
+    {
+        template <typename T> void pod(const T &x)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types");
+            buf.append(reinterpret_cast<const char *>(&x), sizeof(T));
+        }
+
+        std::string buf;
+    };
+}
+
+static void put(Encoder &w, const std::string &x)
+{
+    w.pod<std::uint64_t>(x.size());
+    w.buf.append(x);
+}
+
+static void put(Encoder &w, const Locus &x) { w.pod(x); }
+
+// Interned strings are saved as text, handles are only valid within a process
+static void put(Encoder &w, const IStr &x) { put(w, x.str()); }
+
+template <typename T> static typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type put(Encoder &w, T x)
+{
+    w.pod(x);
+}
+
+template <typename K, typename V, typename C, typename A> static void put(Encoder &w, const std::map<K, V, C, A> &x);
+template <typename T, typename C, typename A> static void put(Encoder &w, const std::set<T, C, A> &x);
+template <typename T> static void put(Encoder &w, const std::vector<T> &x);
+template <typename A, typename B> static void put(Encoder &w, const std::pair<A, B> &x);
+
+static void put(Encoder &w, const ExonData &x)
+{
+    put(w, x.cID); put(w, x.gID); put(w, x.tID); put(w, x.str); put(w, x.l);
+}
+
+static void put(Encoder &w, const TransData &x)
+{
+    put(w, x.cID); put(w, x.gID); put(w, x.tID); put(w, x.l);
+}
+
+static void put(Encoder &w, const GeneData &x)
+{
+    put(w, x.cID); put(w, x.gID); put(w, x.l);
+}
+
+static void put(Encoder &w, const ChrData &x)
+{
+    put(w, x.t2d); put(w, x.g2d); put(w, x.t2e); put(w, x.t2ue); put(w, x.t2ui); put(w, x.t2g);
+    put(w, x.uexons); put(w, x.uintrs); put(w, x.gIDs);
+}
+
+static void put(Encoder &w, const ParserBed::Data &x)
+{
+    put(w, x.cID); put(w, x.strand); put(w, x.l); put(w, x.name);
+}
+
+static void put(Encoder &w, const BedChrData &x) { put(w, x.r2d); }
+
+static void put(Encoder &w, const Variant &x)
+{
+    put(w, x.cID); put(w, x.id); put(w, x.l); put(w, x.status); put(w, x.ref); put(w, x.alt);
+    put(w, x.allF); put(w, x.qual); put(w, x.qualR); put(w, x.qualV); put(w, x.p);
+    put(w, x.readR); put(w, x.readV); put(w, x.depth); put(w, x.options);
+}
+
+static void put(Encoder &w, const VCFChrData &x)
+{
+    put(w, x.s2d); put(w, x.i2d);
+}
+
+static void put(Encoder &w, const VCFChrColumns &x)
+{
+    put(w, x.snps); put(w, x.starts); put(w, x.offs); put(w, x.arena); put(w, x.keys); put(w, x.rows);
+}
+
+static void put(Encoder &w, const GTFTotals &x) { w.pod(x); }
+
+static void put(Encoder &w, const GTFIndex &x)
+{
+    put(w, static_cast<const std::map<ChrID, std::vector<GTFIndex::Range>> &>(x)); put(w, x.totals);
+}
+
+template <typename K, typename V, typename C, typename A> static void put(Encoder &w, const std::map<K, V, C, A> &x)
+{
+    w.pod<std::uint64_t>(x.size());
+
+    for (const auto &i : x)
+    {
+        put(w, i.first);
+        put(w, i.second);
+    }
+}
+
+template <typename T, typename C, typename A> static void put(Encoder &w, const std::set<T, C, A> &x)
+{
+    w.pod<std::uint64_t>(x.size());
+
+    for (const auto &i : x)
+    {
+        put(w, i);
+    }
+}
+
+template <typename T> static void put(Encoder &w, const std::vector<T> &x, std::false_type)
+{
+    for (const auto &i : x)
+    {
+        put(w, i);
+    }
+}
+
+// Same bytes as writing the elements one by one
+template <typename T> static void put(Encoder &w, const std::vector<T> &x, std::true_type)
+{
+    w.buf.append(reinterpret_cast<const char *>(x.data()), x.size() * sizeof(T));
+}
+
+template <typename T> static void put(Encoder &w, const std::vector<T> &x)
+{
+    w.pod<std::uint64_t>(x.size());
+    put(w, x, std::integral_constant<bool, std::is_arithmetic<T>::value>());
+}
+
+template <typename A, typename B> static void put(Encoder &w, const std::pair<A, B> &x)
+{
+    put(w, x.first);
+    put(w, x.second);
+}
+
+/*
+ * ------------------------- Decoding -------------------------
+ */
+
+namespace
+{
+    struct Truncated {};
+}
+
+namespace
+{
+    struct Decoder
+    {
+        template <typename T> void pod(T &x)
+        {
+            if (static_cast<std::size_t>(end - p) < sizeof(T))
+            {
+                throw Truncated();
+            }
+
+            std::memcpy(&x, p, sizeof(T));
+            p += sizeof(T);
+        }
+
+        const char *p, *end;
+    };
+}
+
+static void get(Decoder &d, std::string &x)
+{
+    std::uint64_t n;
+    d.pod(n);
+
+    if (static_cast<std::uint64_t>(d.end - d.p) < n)
+    {
+        throw Truncated();
+    }
+
+    x.assign(d.p, n);
+    d.p += n;
+}
+
+static void get(Decoder &d, Locus &x) { d.pod(x); }
+
+static void get(Decoder &d, IStr &x)
+{
+    std::string s;
+    get(d, s);
+    x = IStr(s);
+}
+
+template <typename T> static typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type get(Decoder &d, T &x)
+{
+    d.pod(x);
+}
+
+template <typename K, typename V, typename C, typename A> static void get(Decoder &d, std::map<K, V, C, A> &x);
+template <typename T, typename C, typename A> static void get(Decoder &d, std::set<T, C, A> &x);
+template <typename T> static void get(Decoder &d, std::vector<T> &x);
+template <typename A, typename B> static void get(Decoder &d, std::pair<A, B> &x);
+
+static void get(Decoder &d, ExonData &x)
+{
+    get(d, x.cID); get(d, x.gID); get(d, x.tID); get(d, x.str); get(d, x.l);
+}
+
+static void get(Decoder &d, TransData &x)
+{
+    get(d, x.cID); get(d, x.gID); get(d, x.tID); get(d, x.l);
+}
+
+static void get(Decoder &d, GeneData &x)
+{
+    get(d, x.cID); get(d, x.gID); get(d, x.l);
+}
+
+static void get(Decoder &d, ChrData &x)
+{
+    get(d, x.t2d); get(d, x.g2d); get(d, x.t2e); get(d, x.t2ue); get(d, x.t2ui); get(d, x.t2g);
+    get(d, x.uexons); get(d, x.uintrs); get(d, x.gIDs);
+}
+
+static void get(Decoder &d, ParserBed::Data &x)
+{
+    get(d, x.cID); get(d, x.strand); get(d, x.l); get(d, x.name);
+}
+
+static void get(Decoder &d, BedChrData &x) { get(d, x.r2d); }
+
+static void get(Decoder &d, Variant &x)
+{
+    get(d, x.cID); get(d, x.id); get(d, x.l); get(d, x.status); get(d, x.ref); get(d, x.alt);
+    get(d, x.allF); get(d, x.qual); get(d, x.qualR); get(d, x.qualV); get(d, x.p);
+    get(d, x.readR); get(d, x.readV); get(d, x.depth); get(d, x.options);
+}
+
+static void get(Decoder &d, VCFChrData &x)
+{
+    get(d, x.s2d); get(d, x.i2d);
+}
+
+static void get(Decoder &d, VCFChrColumns &x)
+{
+    get(d, x.snps); get(d, x.starts); get(d, x.offs); get(d, x.arena); get(d, x.keys); get(d, x.rows);
+}
+
+static void get(Decoder &d, GTFTotals &x) { d.pod(x); }
+
+static void get(Decoder &d, GTFIndex &x)
+{
+    get(d, static_cast<std::map<ChrID, std::vector<GTFIndex::Range>> &>(x)); get(d, x.totals);
+}
+
+template <typename K, typename V, typename C, typename A> static void get(Decoder &d, std::map<K, V, C, A> &x)
+{
+    std::uint64_t n;
+    d.pod(n);
+
+    for (std::uint64_t i = 0; i < n; i++)
+    {
+        K k;
+        get(d, k);
+
+        // Written in order, so always insert at the end
+        get(d, x.emplace_hint(x.end(), std::move(k), V())->second);
+    }
+}
+
+template <typename T, typename C, typename A> static void get(Decoder &d, std::set<T, C, A> &x)
+{
+    std::uint64_t n;
+    d.pod(n);
+
+    for (std::uint64_t i = 0; i < n; i++)
+    {
+        T t;
+        get(d, t);
+        x.emplace_hint(x.end(), std::move(t));
+    }
+}
+
+template <typename T> static void get(Decoder &d, std::vector<T> &x, std::uint64_t n, std::false_type)
+{
+    for (std::uint64_t i = 0; i < n; i++)
+    {
+        T t;
+        get(d, t);
+        x.push_back(std::move(t));
+    }
+}
+
+template <typename T> static void get(Decoder &d, std::vector<T> &x, std::uint64_t n, std::true_type)
+{
+    if (static_cast<std::uint64_t>(d.end - d.p) / sizeof(T) < n)
+    {
+        throw Truncated();
+    }
+
+    x.resize(n);
+    std::memcpy(x.data(), d.p, n * sizeof(T));
+    d.p += n * sizeof(T);
+}
+
+template <typename T> static void get(Decoder &d, std::vector<T> &x)
+{
+    std::uint64_t n;
+    d.pod(n);
+    get(d, x, n, std::integral_constant<bool, std::is_arithmetic<T>::value>());
+}
+
+template <typename A, typename B> static void get(Decoder &d, std::pair<A, B> &x)
+{
+    get(d, x.first);
+    get(d, x.second);
+}
+
+/*
+ * ------------------------- Files -------------------------
+ */
+
+std::string Snapshot::path(std::uint64_t hash, const std::string &kind)
+{
+    return (boost::format("%1%/%2%-%3$016x.snap") % dir % kind % hash).str();
+}
+
+namespace
+{
+// Memory-mapped snapshot, unmapped when out of scope
+struct Mapped
+{
+    Mapped(const std::string &file)
+    {
+        const auto fd = open(file.c_str(), O_RDONLY);
+
+        if (fd < 0)
+        {
+            return;
+        }
+
+        struct stat s;
+
+        if (!fstat(fd, &s) && s.st_size >= static_cast<off_t>(sizeof(Header)))
+        {
+            const auto m = mmap(nullptr, s.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (m != MAP_FAILED)
+            {
+                data = static_cast<const char *>(m);
+                size = s.st_size;
+            }
+        }
+
+        close(fd);
+    }
+
+    ~Mapped()
+    {
+        if (data)
+        {
+            munmap(const_cast<char *>(data), size);
+        }
+    }
+
+    const char *data = nullptr;
+    std::size_t size = 0;
+};
+}
+
+template <typename T> static bool loadSnapshot(std::uint64_t hash, const std::string &kind, T &x)
+{
+    const auto file = Snapshot::path(hash, kind);
+
+    Mapped m(file);
+
+    if (!m.data)
+    {
+        return false;
+    }
+
+    Header h;
+    std::memcpy(&h, m.data, sizeof(Header));
+
+    if (std::memcmp(h.magic, Magic, sizeof(Magic)) ||
+        h.version != Snapshot::Version             ||
+        h.base    != sizeof(Base)                  ||
+        h.hash    != hash                          ||
+        h.size    != m.size - sizeof(Header))
+    {
+        return false;
+    }
+
+    Decoder d;
+    d.p   = m.data + sizeof(Header);
+    d.end = m.data + m.size;
+
+    try
+    {
+        T t;
+        get(d, t);
+
+        if (d.p != d.end)
+        {
+            return false;
+        }
+
+        x = std::move(t);
+        return true;
+    }
+    catch (const Truncated &)
+    {
+        return false;
+    }
+}
+
+template <typename T> static void saveSnapshot(std::uint64_t hash, const std::string &kind, const T &x)
+{
+    const auto file = Snapshot::path(hash, kind);
+
+    Encoder w;
+    put(w, x);
+
+    Header h;
+    std::memcpy(h.magic, Magic, sizeof(Magic));
+    h.version = Snapshot::Version;
+    h.base    = sizeof(Base);
+    h.hash    = hash;
+    h.size    = w.buf.size();
+
+    // Write to a temporary file first, so that a snapshot is never seen half-written
+    const auto tmp = file + "." + std::to_string(getpid());
+
+    std::ofstream o(tmp, std::ios::binary);
+    o.write(reinterpret_cast<const char *>(&h), sizeof(Header));
+    o.write(w.buf.data(), w.buf.size());
+    o.close();
+
+    if (!o || rename(tmp.c_str(), file.c_str()))
+    {
+        unlink(tmp.c_str());
+    }
+}
+
+bool Snapshot::load(std::uint64_t hash, const std::string &kind, GTFData &x)
+{
+    // Same as gtfData(), the annotation is allocated from its own arena
+    Arena::Scope scope(std::make_shared<Arena>());
+    return loadSnapshot(hash, kind, x);
+}
+
+bool Snapshot::load(std::uint64_t hash, const std::string &kind, VCFData &x)
+{
+    // Same as vcfData(), the index isn't saved
+    if (!loadSnapshot(hash, kind, x))
+    {
+        return false;
+    }
+
+    x.index();
+    return true;
+}
+
+bool Snapshot::load(std::uint64_t hash, const std::string &kind, BedData &x) { return loadSnapshot(hash, kind, x); }
+bool Snapshot::load(std::uint64_t hash, const std::string &kind, GTFIndex &x) { return loadSnapshot(hash, kind, x); }
+bool Snapshot::load(std::uint64_t hash, const std::string &kind, VCFColumns &x) { return loadSnapshot(hash, kind, x); }
+
+void Snapshot::save(std::uint64_t hash, const std::string &kind, const BedData &x) { saveSnapshot(hash, kind, x); }
+void Snapshot::save(std::uint64_t hash, const std::string &kind, const GTFData &x) { saveSnapshot(hash, kind, x); }
+void Snapshot::save(std::uint64_t hash, const std::string &kind, const VCFData &x) { saveSnapshot(hash, kind, x); }
+void Snapshot::save(std::uint64_t hash, const std::string &kind, const GTFIndex &x) { saveSnapshot(hash, kind, x); }
+void Snapshot::save(std::uint64_t hash, const std::string &kind, const VCFColumns &x) { saveSnapshot(hash, kind, x); }
@@ -0,0 +1,80 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <string>
+#include <cstdint>
+#include "data/reader.hpp"
+
+namespace Anaquin
+{
+    struct BedData;
+    struct GTFData;
+    struct VCFData;
+    struct GTFIndex;
+    struct VCFColumns;
+
+    /*
+     * Versioned binary snapshots of parsed reference annotations. A snapshot is keyed by a hash of
+     * the content of the source, so later runs against the same annotation map the snapshot rather
+     * than parsing the source again. Snapshots are only used if a cache directory is given.
+     */
+
+    struct Snapshot
+    {
+        // Bumped whenever the layout of a snapshot, or of any type saved in one, changes
+        static const std::uint32_t Version = 3;
+
+        // Directory for the snapshots, empty for no caching
+        static std::string dir;
+
+        // Where the snapshot for a source with the hash would be
+        static std::string path(std::uint64_t hash, const std::string &kind);
+
+        /*
+         * Load the snapshot for a source with the hash (see Reader::hash()). Returns false if there isn't
+         * one (or it's not valid), the data is not modified in that case.
+         */
+
+        static bool load(std::uint64_t hash, const std::string &kind, BedData &);
+        static bool load(std::uint64_t hash, const std::string &kind, GTFData &);
+        static bool load(std::uint64_t hash, const std::string &kind, VCFData &);
+        static bool load(std::uint64_t hash, const std::string &kind, GTFIndex &);
+        static bool load(std::uint64_t hash, const std::string &kind, VCFColumns &);
+
+        // Write a snapshot for a source with the hash, failing to write isn't an error
+        static void save(std::uint64_t hash, const std::string &kind, const BedData &);
+        static void save(std::uint64_t hash, const std::string &kind, const GTFData &);
+        static void save(std::uint64_t hash, const std::string &kind, const VCFData &);
+        static void save(std::uint64_t hash, const std::string &kind, const GTFIndex &);
+        static void save(std::uint64_t hash, const std::string &kind, const VCFColumns &);
+
+        /*
+         * Load the snapshot for the source, otherwise parse the source and save a snapshot. Sources
+         * that can't be read twice (eg: pipes) are always parsed.
+         */
+
+        template <typename T, typename F> static T cached(const Reader &r, const std::string &kind, F parse)
+        {
+            T x;
+
+            const auto cache = !dir.empty() && r.canReset();
+            const auto hash  = cache ? r.hash() : 0;
+
+            if (cache && load(hash, kind, x))
+            {
+                return x;
+            }
+
+            x = parse(r);
+
+            if (cache)
+            {
+                save(hash, kind, x);
+            }
+
+            return x;
+        }
+    };
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "data/reader.hpp"
 #include "data/tokens.hpp"
 #include "tools/errors.hpp"
+#include "data/convert.hpp"
 #include "data/standard.hpp"
 #include "parsers/parser_fa.hpp"
 #include "parsers/parser_csv.hpp"
@@ -33,19 +34,19 @@ static unsigned countColumns(const Reader &r)
     ParserCSV::parse(r, [&](const ParserCSV::Data &d, const ParserProgress &p)
     {
         n = std::max(n, d.size());
-    }, ",");
+    }, ',');
 
     ParserCSV::parse(Reader(r), [&](const ParserCSV::Data &d, const ParserProgress &p)
     {
         n = std::max(n, d.size());
-    }, "\t");
+    }, '\t');
     
     return static_cast<unsigned>(n);
 }
 
 template <typename Reference> void readMixture(const Reader &r, Reference &ref, Mixture m, MixtureFormat format, unsigned column=2)
 {
-    auto f = [&](const std::string &delim)
+    auto f = [&](char delim)
     {
         const auto t = Reader(r);
 
@@ -54,20 +55,20 @@ template <typename Reference> void readMixture(const Reader &r, Reference &ref,
         ParserCSV::parse(t, [&](const ParserCSV::Data &d, const ParserProgress &p)
         {
             // Don't bother if this is the first line or an invalid line
-            if (p.i == 0 || d.size() <= 1)
+            if (p.i == 0 || d.size() <= column)
             {
                 return;
             }
             
-            const auto seq = d[0];
-            const auto con = stof(d[column]);
+            const auto seq = d[0].to_string();
+            const auto con = s2f(d[column]);
             
             switch (format)
             {
                 case ID_Length_Mix:
                 {
                     n++;
-                    ref.add(seq, stoi(d[1]), con, m); break;
+                    ref.add(seq, s2i(d[1]), con, m); break;
                 }
                     
                 case ID_Mix:
@@ -81,7 +82,7 @@ template <typename Reference> void readMixture(const Reader &r, Reference &ref,
         return n ? true : false;
     };
     
-    if (!f("\t") && !f(","))
+    if (!f('\t') && !f(','))
     {
         throw std::runtime_error("No sequin is found in the mixture file. Please check and try again.");
     }
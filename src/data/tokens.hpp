@@ -2,8 +2,11 @@
 #define TOKENS_HPP
 
 #include <vector>
+#include <cstring>
+#include <assert.h>
 #include "data/data.hpp"
 #include <boost/algorithm/string.hpp>
+#include <boost/utility/string_ref.hpp>
 
 namespace Anaquin
 {
@@ -25,6 +28,70 @@ namespace Anaquin
             return toks[0];
         }
     };
+
+    /*
+     * Same as Tokens::split() but the fields point into the line, nothing is copied. The array of
+     * fields is kept for the next line, so parsing a file doesn't allocate once it's large enough.
+     * The fields are only valid as long as the line.
+     */
+
+    class Fields
+    {
+        public:
+
+            typedef boost::string_ref Field;
+
+            // Split the line by the delimiter, returns the number of fields
+            inline std::size_t split(Field l, char d)
+            {
+                _n = 0;
+
+                for (;;)
+                {
+                    const auto p = static_cast<const char *>(std::memchr(l.data(), d, l.size()));
+
+                    if (!p)
+                    {
+                        add(l);
+                        return _n;
+                    }
+
+                    add(Field(l.data(), p - l.data()));
+                    l.remove_prefix(p - l.data() + 1);
+                }
+            }
+
+            inline std::size_t size() const { return _n; }
+
+            inline Field operator[](std::size_t i) const
+            {
+                assert(i < _n);
+                return _fields[i];
+            }
+
+            inline const Field *begin() const { return _fields.data(); }
+            inline const Field *end()   const { return _fields.data() + _n; }
+
+        private:
+
+            inline void add(Field x)
+            {
+                if (_n == _fields.size())
+                {
+                    _fields.push_back(x);
+                }
+                else
+                {
+                    _fields[_n] = x;
+                }
+
+                _n++;
+            }
+
+            std::size_t _n = 0;
+
+            std::vector<Field> _fields;
+    };
 }
 
-#endif
\ No newline at end of file
+#endif
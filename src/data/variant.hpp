@@ -9,15 +9,74 @@
 
 namespace Anaquin
 {
+    /*
+     * Hash for "<id>_<type>_<start>_<end>", written without formatting into a buffer that is reused
+     * across calls. Values are the same as hashing the formatted string.
+     */
+
     inline long var2hash(const SequinID &id, Mutation type, const Locus &l)
     {
-        const auto str = (boost::format("%1%_%2%_%3%_%4%") % id
-                                                           % type
-                                                           % l.start
-                                                           % l.end).str();
+        static thread_local std::string str;
+
+        auto add = [&](long long x)
+        {
+            char buf[24], *p = buf + sizeof(buf);
+            const auto neg = x < 0;
+            auto u = neg ? -static_cast<unsigned long long>(x) : static_cast<unsigned long long>(x);
+
+            do
+            {
+                *--p = '0' + (u % 10);
+                u /= 10;
+            }
+            while (u);
+
+            if (neg)
+            {
+                *--p = '-';
+            }
+
+            str.push_back('_');
+            str.append(p, buf + sizeof(buf));
+        };
+
+        str.assign(id);
+        add(type);
+        add(l.start);
+        add(l.end);
+
         return std::hash<std::string>{}(str);
     }
     
+    /*
+     * Type of a variant from its alleles, "-" and "+" are the deletions and insertions written by
+     * VarScan. Works on anything with size() and [] (eg: string views into a line).
+     */
+
+    template <typename S> inline Mutation varType(const S &ref, const S &alt)
+    {
+        if (alt[0] == '-')
+        {
+            return Deletion;
+        }
+        else if (alt[0] == '+')
+        {
+            return Insertion;
+        }
+        else if (ref.size() == alt.size())
+        {
+            return SNP;
+        }
+        else if (ref.size() > alt.size())
+        {
+            return Deletion;
+        }
+        else
+        {
+            return Insertion;
+        }
+    }
+
     struct Variant
     {
         enum Status
@@ -33,26 +92,7 @@ namespace Anaquin
 
         inline Mutation type() const
         {
-            if (alt[0] == '-')
-            {
-                return Deletion;
-            }
-            else if (alt[0] == '+')
-            {
-                return Insertion;
-            }
-            else if (ref.size() == alt.size())
-            {
-                return SNP;
-            }
-            else if (ref.size() > alt.size())
-            {
-                return Deletion;
-            }
-            else
-            {
-                return Insertion;
-            }
+            return varType(ref, alt);
         }
 
         inline Proportion alleleFreq() const
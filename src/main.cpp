@@ -29,7 +29,10 @@
 #include "MetaQuin/m_report.hpp"
 #include "MetaQuin/m_assembly.hpp"
 
+#include "data/snapshot.hpp"
+
 #include "parsers/parser_gtf.hpp"
+#include "parsers/parser_sam.hpp"
 #include "parsers/parser_blat.hpp"
 #include "parsers/parser_fold.hpp"
 #include "parsers/parser_cdiff.hpp"
@@ -105,6 +108,9 @@ typedef std::set<Value> Range;
 #define OPT_U_BASE  900
 #define OPT_U_FILES 909
 #define OPT_EDGE    910
+#define OPT_WINDOW  911
+#define OPT_FP_READ 912
+#define OPT_CACHE   913
 
 using namespace Anaquin;
 
@@ -351,6 +357,9 @@ static const struct option long_options[] =
 
     { "edge",    required_argument, 0, OPT_EDGE   },
     { "fuzzy",   required_argument, 0, OPT_FUZZY  },
+    { "window",  required_argument, 0, OPT_WINDOW },
+    { "fpreads", required_argument, 0, OPT_FP_READ },
+    { "cache",   required_argument, 0, OPT_CACHE   },
     
     { "o",       required_argument, 0, OPT_PATH },
     { "output",  required_argument, 0, OPT_PATH },
@@ -681,6 +690,21 @@ template < typename Analyzer> void analyze_n(typename Analyzer::Options o = type
     }, o);
 }
 
+static void parseFPReads(FPReadOptions &o)
+{
+    if (_p.opts.count(OPT_FP_READ))
+    {
+        if (_p.opts[OPT_FP_READ] == "stream")
+        {
+            o.fpStream = true;
+        }
+        else
+        {
+            o.fpSample = stoi(_p.opts[OPT_FP_READ]);
+        }
+    }
+}
+
 static void fixInputs(int argc, char ** argv)
 {
     for (auto i = 0; i < argc; i++)
@@ -884,6 +908,74 @@ void parse(int argc, char ** argv)
                 break;
             }
 
+            case OPT_WINDOW:
+            {
+                switch (_p.tool)
+                {
+                    case TOOL_R_ALIGN:
+                    case TOOL_V_SUBSAMPLE: { break; }
+                    default:
+                    {
+                        throw std::runtime_error("Invalid command. -window is only supported by RnaAlign and VarSubsample.");
+                    }
+                }
+                
+                try
+                {
+                    if (stoi(val) <= 0)
+                    {
+                        throw std::runtime_error("");
+                    }
+
+                    _p.opts[opt] = val;
+                }
+                catch (...)
+                {
+                    throw std::runtime_error(val + " is not a positive integer. Please check and try again.");
+                }
+                
+                break;
+            }
+
+            case OPT_FP_READ:
+            {
+                switch (_p.tool)
+                {
+                    case TOOL_V_ALIGN:
+                    case TOOL_M_ALIGN: { break; }
+                    default:
+                    {
+                        throw std::runtime_error("Invalid command. -fpreads is only supported by VarAlign and MetaAlign.");
+                    }
+                }
+
+                // Either streaming or the size of the sample
+                if (val != "stream")
+                {
+                    std::size_t n = 0;
+                    
+                    try
+                    {
+                        if (stoi(val, &n) <= 0)
+                        {
+                            n = 0;
+                        }
+                    }
+                    catch (...)
+                    {
+                        n = 0;
+                    }
+
+                    if (n != val.size())
+                    {
+                        throw InvalidValueException("fpreads", val);
+                    }
+                }
+
+                _p.opts[opt] = val;
+                break;
+            }
+
             case OPT_METHOD:
             {
                 switch (_p.tool)
@@ -939,6 +1031,15 @@ void parse(int argc, char ** argv)
 
             case OPT_PATH: { _p.path = val; break; }
 
+            case OPT_CACHE:
+            {
+                system(("mkdir -p " + val).c_str());
+                
+                // Snapshots of the references are kept there
+                Snapshot::dir = val;
+                break;
+            }
+
             default:
             {
                 throw InvalidOptionException(argv[index]);
@@ -1027,6 +1128,9 @@ void parse(int argc, char ** argv)
 
                     case TOOL_R_ALIGN:
                     {
+                        // Chromosomes the reads weren't aligned to can't have any alignment
+                        s.r_rna.loadOnly(ParserSAM::header(_p.opts.at(OPT_U_FILES)));
+
                         addRef(std::bind(&Standard::addRRef, &s, std::placeholders::_1));
                         break;
                     }
@@ -1064,7 +1168,19 @@ void parse(int argc, char ** argv)
             switch (_p.tool)
             {
                 case TOOL_R_GENE:     { analyze_0<RGene>();                         break; }
-                case TOOL_R_ALIGN:    { analyze_1<RAlign>(OPT_U_FILES);             break; }
+                case TOOL_R_ALIGN:
+                {
+                    RAlign::Options o;
+                    
+                    if (_p.opts.count(OPT_WINDOW))
+                    {
+                        o.window = stoi(_p.opts[OPT_WINDOW]);
+                    }
+                    
+                    analyze_1<RAlign>(OPT_U_FILES, o);
+                    break;
+                }
+
                 case TOOL_R_ASSEMBLY: { analyze_1<RAssembly>(OPT_U_FILES);          break; }
                 case TOOL_R_REPORT:
                 {
@@ -1260,7 +1376,13 @@ void parse(int argc, char ** argv)
                     break;
                 }
 
-                case TOOL_M_ALIGN: { analyze_n<MAlign>(); break; }
+                case TOOL_M_ALIGN:
+                {
+                    MAlign::Options o;
+                    parseFPReads(o);
+                    analyze_n<MAlign>(o);
+                    break;
+                }
 
                 default: { break; }
             }
@@ -1352,7 +1474,13 @@ void parse(int argc, char ** argv)
                 }
 
                 case TOOL_V_FLIP:  { analyze_1<VFlip>(OPT_U_FILES); break; }
-                case TOOL_V_ALIGN: { analyze_2<VAlign>(OPT_U_FILES); break; }
+                case TOOL_V_ALIGN:
+                {
+                    VAlign::Options o;
+                    parseFPReads(o);
+                    analyze_2<VAlign>(OPT_U_FILES, o);
+                    break;
+                }
 
                 case TOOL_V_ALLELE:
                 {
@@ -1440,6 +1568,11 @@ void parse(int argc, char ** argv)
                         o.edge = stoi(_p.opts[OPT_EDGE]);
                     }
 
+                    if (_p.opts.count(OPT_WINDOW))
+                    {
+                        o.window = stoi(_p.opts[OPT_WINDOW]);
+                    }
+
                     analyze_2<VSample>(OPT_U_FILES, o);
                     break;
                 }
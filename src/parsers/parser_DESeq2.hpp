@@ -26,13 +26,13 @@ namespace Anaquin
 
         static bool isDESeq2(const Reader &r)
         {
-            std::string line;
-            std::vector<Token> toks;
+            boost::string_ref line;
+            Fields toks;
             
             // Read the header
-            if (r.nextLine(line))
+            if (r.nextView(line))
             {
-                Tokens::split(line, ",", toks);
+                toks.split(line, ',');
                 
                 if (toks.size() == 7             &&
                     toks[1]  == "baseMean"       &&
@@ -54,21 +54,21 @@ namespace Anaquin
             Reader r(file);
             ParserProgress p;
             
-            std::string line;
-            std::vector<std::string> toks;
+            boost::string_ref line;
+            Fields toks;
             
             // We'll need it for checking sequin genes
             const auto &s = Standard::instance().r_rna;
             
-            while (r.nextLine(line))
+            while (r.nextView(line))
             {
-                Tokens::split(line, ",", toks);
+                toks.split(line, ',');
 
                 Data t;
 
                 if (p.i)
                 {
-                    t.gID = toks[Field::Name];
+                    t.gID = toks[Field::Name].to_string();
                     
                     if (t.gID == "R2_33")
                     {
@@ -108,12 +108,12 @@ namespace Anaquin
                         // Standard error for the log-fold change
                         t.logFSE = s2d(toks[Field::Log2FoldSE]);
                         
-                        t.p = stold(toks[Field::PValue]);
+                        t.p = s2ld(toks[Field::PValue]);
                         
                         try
                         {
                             // Not always available, but we can still proceed if we have p-value
-                            t.q = stold(toks[Field::QValue]);
+                            t.q = s2ld(toks[Field::QValue]);
                         }
                         catch (...)
                         {
@@ -0,0 +1,384 @@
+#include <climits>
+#include <cstring>
+#include <unistd.h>
+#include <algorithm>
+#include <htslib/tbx.h>
+#include <htslib/vcf.h>
+#include "parsers/parser_bcf.hpp"
+#include <boost/algorithm/string/predicate.hpp>
+
+using namespace Anaquin;
+
+bool ParserBCF::isBCF(const Reader &r)
+{
+    return boost::algorithm::ends_with(r.src(), ".vcf.gz")  ||
+           boost::algorithm::ends_with(r.src(), ".vcf.bgz") ||
+           boost::algorithm::ends_with(r.src(), ".bcf");
+}
+
+namespace
+{
+    // File opened with its header (and index if asked), closed when out of scope
+    struct BCFFile
+    {
+        BCFFile(const FileName &file, bool indexed = false) : file(file)
+        {
+            if (!(f = hts_open(file.c_str(), "r")))
+            {
+                throw std::runtime_error("Failed to open: " + file);
+            }
+            else if (!(h = bcf_hdr_read(f)))
+            {
+                hts_close(f);
+                throw std::runtime_error("Failed to read the header: " + file);
+            }
+
+            b = bcf_init();
+
+            // htslib complains if there's no index, so check first
+            if (indexed && isVCF() && !access((file + ".tbi").c_str(), R_OK))
+            {
+                tbx = tbx_index_load(file.c_str());
+                idx = tbx ? tbx->idx : nullptr;
+            }
+            else if (indexed && !isVCF() && !access((file + ".csi").c_str(), R_OK))
+            {
+                idx = bcf_index_load(file.c_str());
+            }
+        }
+
+        ~BCFFile()
+        {
+            free(fs);
+            free(is);
+            free(cs);
+            free(str.s);
+
+            if (tbx)      { tbx_destroy(tbx); }
+            else if (idx) { hts_idx_destroy(idx); }
+
+            bcf_destroy(b);
+            bcf_hdr_destroy(h);
+            hts_close(f);
+        }
+
+        inline bool isVCF() const { return f->format.format == vcf; }
+
+        inline int tid(const ChrID &cID) const
+        {
+            return tbx ? tbx_name2id(tbx, cID.c_str()) : bcf_hdr_name2id(h, cID.c_str());
+        }
+
+        inline hts_itr_t *query(int tid, Base start, Base end) const
+        {
+            const auto beg = static_cast<int>(std::max<Base>(start - 1, 0));
+            const auto lim = static_cast<int>(std::min<Base>(end - 1, INT_MAX));
+
+            return hts_itr_query(idx, tid, beg, lim, tbx ? tbx_readrec : bcf_readrec);
+        }
+
+        // Next record of the iterator, false if there's no more
+        inline bool next(hts_itr_t *itr)
+        {
+            int r;
+
+            if (tbx)
+            {
+                if ((r = tbx_itr_next(f, tbx, itr, &str)) >= 0 && vcf_parse(&str, h, b) < 0)
+                {
+                    throw std::runtime_error("Invalid record in: " + file);
+                }
+            }
+            else
+            {
+                r = bcf_itr_next(f, itr, b);
+            }
+
+            if (r < -1)
+            {
+                throw std::runtime_error("Failed to read: " + file);
+            }
+
+            return r >= 0;
+        }
+
+        // Same as ParserVCF, returns false for anything that is not really a variant
+        bool convert(ParserBCF::Data &x)
+        {
+            bcf_unpack(b, BCF_UN_ALL);
+
+            // Anaquin doesn't support multi-alleles (because sequins don't have it)
+            if (b->n_allele < 2 || !strcmp(b->d.allele[1], "."))
+            {
+                return false;
+            }
+
+            x = ParserBCF::Data();
+
+            x.cID = cID(b->rid);
+            x.id  = b->d.id;
+            x.ref = b->d.allele[0];
+            x.alt = b->d.allele[1];
+
+            // htslib has 0-based positions
+            x.l.start = x.l.end = b->pos + 1;
+
+            x.qual = bcf_float_is_missing(b->qual) ? NAN : b->qual;
+
+            // Measured allele frequency, the first for multiple alleles
+            if (bcf_get_info_float(h, b, "AF", &fs, &nfs) > 0 && !bcf_float_is_missing(fs[0]))
+            {
+                x.allF = fs[0];
+            }
+
+            // Not defined in the header, so it's kept as text
+            else if (bcf_get_info_string(h, b, "AF", &cs, &ncs) > 0)
+            {
+                x.allF = strtof(cs, nullptr);
+            }
+
+            if (b->n_sample)
+            {
+                std::vector<double> ad, dp;
+
+                format("AD", ad);
+                format("DP", dp);
+
+                if (!ad.empty())
+                {
+                    x.readR = ad[0];
+                    x.readV = ad.size() > 1 ? ad[1] : ad[0];
+                }
+
+                if (!dp.empty())
+                {
+                    x.depth = dp[0];
+                }
+            }
+
+            return true;
+        }
+
+        // Values of the first sample, either integers or text if not defined in the header
+        void format(const char *tag, std::vector<double> &x)
+        {
+            auto n = bcf_get_format_int32(h, b, tag, &is, &nis);
+
+            if (n > 0)
+            {
+                for (auto i = 0; i < n / b->n_sample && is[i] != bcf_int32_vector_end; i++)
+                {
+                    if (is[i] != bcf_int32_missing)
+                    {
+                        x.push_back(is[i]);
+                    }
+                }
+            }
+            else if ((n = bcf_get_format_char(h, b, tag, &cs, &ncs)) > 0)
+            {
+                // Eg: "15,15", padded with nulls
+                const auto s = std::string(cs, strnlen(cs, n / b->n_sample));
+
+                for (const char *p = s.c_str(), *end; *p; p = *end ? end + 1 : end)
+                {
+                    const auto v = strtod(p, const_cast<char **>(&end));
+
+                    if (end == p)
+                    {
+                        break;
+                    }
+
+                    x.push_back(v);
+                }
+            }
+        }
+
+        // Names are copied once for each chromosome, not for every record
+        inline const ChrID &cID(int rid)
+        {
+            if (rid >= static_cast<int>(cIDs.size()))
+            {
+                cIDs.resize(rid + 1);
+            }
+
+            if (cIDs[rid].empty())
+            {
+                cIDs[rid] = bcf_hdr_id2name(h, rid);
+            }
+
+            return cIDs[rid];
+        }
+
+        const FileName file;
+
+        htsFile   *f;
+        bcf_hdr_t *h;
+        bcf1_t    *b;
+
+        // Index for .vcf.gz (tabix) or .bcf (CSI)
+        tbx_t *tbx = nullptr;
+        hts_idx_t *idx = nullptr;
+
+        // Buffers for the values, reused across records
+        float   *fs = nullptr;
+        int32_t *is = nullptr;
+        char    *cs = nullptr;
+        int nfs = 0, nis = 0, ncs = 0;
+
+        // Line read by tabix
+        kstring_t str = { 0, 0, nullptr };
+
+        std::vector<ChrID> cIDs;
+    };
+}
+
+void ParserBCF::parse(const FileName &file, Functor f)
+{
+    BCFFile x(file);
+
+    Data d;
+    ParserProgress p;
+
+    int r;
+
+    while ((r = bcf_read(x.f, x.h, x.b)) >= 0)
+    {
+        p.i++;
+
+        if (p.stopped)
+        {
+            break;
+        }
+        else if (x.convert(d))
+        {
+            f(d, p);
+        }
+    }
+
+    if (r < -1)
+    {
+        throw std::runtime_error("Failed to read: " + file);
+    }
+}
+
+std::vector<ParserBCF::Region> ParserBCF::regions(const FileName &file, unsigned n)
+{
+    BCFFile x(file, true);
+
+    if (!x.idx)
+    {
+        return std::vector<Region>();
+    }
+
+    int m;
+
+    const auto names = x.tbx ? tbx_seqnames(x.tbx, &m) : bcf_index_seqnames(x.idx, x.h, &m);
+
+    // Offset of the first record in each chromosome, chromosomes without records are skipped
+    std::vector<std::pair<std::uint64_t, ChrID>> cIDs;
+
+    for (auto i = 0; i < m; i++)
+    {
+        std::uint64_t mapped, unmapped;
+
+        // Querying a chromosome without records might not return (htslib loops on small indexes)
+        if (hts_idx_get_stat(x.idx, x.tid(names[i]), &mapped, &unmapped) || !(mapped + unmapped))
+        {
+            continue;
+        }
+
+        const auto itr = x.query(x.tid(names[i]), 0, INT_MAX);
+
+        if (itr && itr->n_off)
+        {
+            cIDs.push_back(std::make_pair(itr->off[0].u, ChrID(names[i])));
+        }
+
+        hts_itr_destroy(itr);
+    }
+
+    free(names);
+
+    // The same order as reading the file from the start
+    std::sort(cIDs.begin(), cIDs.end());
+
+    std::vector<Region> rs;
+
+    for (const auto &i : cIDs)
+    {
+        const auto rid = bcf_hdr_name2id(x.h, i.second.c_str());
+
+        // Length in the header, zero if unknown
+        const Base len = rid >= 0 ? x.h->id[BCF_DT_CTG][rid].val->info[0] : 0;
+
+        const auto k = len ? std::max(n, 1u) : 1u;
+        const auto step = (len + k - 1) / k;
+
+        for (auto j = 0u; j < k; j++)
+        {
+            rs.push_back(Region { i.second, j ? 1 + j * step : 0, j + 1 < k ? 1 + (j + 1) * step : INT_MAX });
+        }
+    }
+
+    return rs;
+}
+
+void ParserBCF::parse(const FileName &file, const Region &r, Functor f)
+{
+    BCFFile x(file, true);
+
+    if (!x.idx)
+    {
+        throw std::runtime_error("No index for: " + file);
+    }
+
+    const auto tid = x.tid(r.cID);
+
+    std::uint64_t mapped, unmapped;
+
+    // Nothing in the chromosome (and querying it might not return)
+    if (tid < 0 || hts_idx_get_stat(x.idx, tid, &mapped, &unmapped) || !(mapped + unmapped))
+    {
+        return;
+    }
+
+    const auto itr = x.query(tid, r.start, r.end);
+
+    if (!itr)
+    {
+        throw std::runtime_error("Failed to query " + r.cID + " in: " + file);
+    }
+
+    Data d;
+    ParserProgress p;
+
+    try
+    {
+        while (x.next(itr))
+        {
+            // Records overlapping the start belong to the region before
+            if (x.b->pos + 1 < r.start || x.b->pos + 1 >= r.end)
+            {
+                continue;
+            }
+
+            p.i++;
+
+            if (p.stopped)
+            {
+                break;
+            }
+            else if (x.convert(d))
+            {
+                f(d, p);
+            }
+        }
+    }
+    catch (...)
+    {
+        hts_itr_destroy(itr);
+        throw;
+    }
+
+    hts_itr_destroy(itr);
+}
@@ -0,0 +1,48 @@
+#ifndef PARSER_BCF_HPP
+#define PARSER_BCF_HPP
+
+#include <vector>
+#include <functional>
+#include "data/reader.hpp"
+#include "data/variant.hpp"
+#include "parsers/parser.hpp"
+
+namespace Anaquin
+{
+    /*
+     * Bgzipped VCF (.vcf.gz) and BCF files, read by htslib. Records are converted to the same
+     * variants as ParserVCF.
+     */
+
+    struct ParserBCF
+    {
+        typedef CalledVariant Data;
+
+        // Variants starting in [start, end) of a chromosome, positions are 1-based
+        struct Region
+        {
+            ChrID cID;
+            Base start, end;
+        };
+
+        typedef std::function<void (const Data &, ParserProgress &)> Functor;
+
+        // Eg: "A.vcf.gz" or "A.bcf"
+        static bool isBCF(const Reader &);
+
+        static void parse(const FileName &, Functor);
+
+        /*
+         * Regions of an indexed file (.tbi for .vcf.gz, .csi for .bcf), in the order of the file.
+         * Chromosomes with a length in the header are split into n regions. Empty if the file
+         * isn't indexed.
+         */
+
+        static std::vector<Region> regions(const FileName &, unsigned n = 1);
+
+        // Parse the variants in a region, the file must be indexed
+        static void parse(const FileName &, const Region &, Functor);
+    };
+}
+
+#endif
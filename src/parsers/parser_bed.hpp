@@ -4,8 +4,9 @@
 #include <iostream>
 #include "data/locus.hpp"
 #include "data/reader.hpp"
+#include "data/tokens.hpp"
+#include "data/convert.hpp"
 #include "parsers/parser.hpp"
-#include <boost/algorithm/string.hpp>
 
 namespace Anaquin
 {
@@ -33,18 +34,19 @@ namespace Anaquin
                 Data d;
                 ParserProgress p;
                 
-                std::vector<std::string> sizes, starts, tokens;
+                Fields tokens;
+                boost::string_ref line;
                 
-                while (r.nextTokens(tokens, "\t"))
+                while (r.nextView(line))
                 {
                     // Empty line?
-                    if (tokens.size() == 1)
+                    if (tokens.split(line, '\t') == 1)
                     {
                         return;
                     }
                     
                     // Name of the chromosome
-                    d.cID = tokens[0];
+                    d.cID.assign(tokens[0].data(), tokens[0].size());
                     
                     /*
                      * https://genome.ucsc.edu/FAQ/FAQformat.html#format1
@@ -53,7 +55,7 @@ namespace Anaquin
                      * The end position requies no increment because it is "not included in the display".
                      */
                     
-                    d.l = Locus(stod(tokens[1])+1, stod(tokens[2]));
+                    d.l = Locus(s2i(tokens[1])+1, s2i(tokens[2]));
                     
                     if (tokens.size() >= 6)
                     {
@@ -64,7 +66,7 @@ namespace Anaquin
                     if (tokens.size() >= 4)
                     {
                         // Name of the BED line (eg: gene)
-                        d.name = tokens[3];
+                        d.name.assign(tokens[3].data(), tokens[3].size());
                     }
                     
                     f(d, p);
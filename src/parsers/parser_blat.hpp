@@ -5,6 +5,7 @@
 #include "data/data.hpp"
 #include "data/reader.hpp"
 #include "data/tokens.hpp"
+#include "data/convert.hpp"
 #include "parsers/parser.hpp"
 #include <boost/algorithm/string.hpp>
 #include <iostream>
@@ -169,44 +170,44 @@ namespace Anaquin
             {
                 ParserProgress p;
                 
-                std::string line;
-                std::vector<std::string> toks;
+                boost::string_ref line;
+                Fields toks;
                 
                 Data l;
                 
-                while (r.nextLine(line))
+                while (r.nextView(line))
                 {
                     if (p.i++ <= 3)
                     {
                         continue;
                     }
                     
-                    Tokens::split(line, "\t", toks);
+                    toks.split(line, '\t');
                     
                     if (toks.size() != 21)
                     {
-                        throw std::runtime_error("Invalid line: " + line);
+                        throw std::runtime_error("Invalid line: " + line.to_string());
                     }
                     
-                    l.qName     = toks[PSL_QName];
-                    l.tName     = toks[PSL_TName];
+                    l.qName.assign(toks[PSL_QName].data(), toks[PSL_QName].size());
+                    l.tName.assign(toks[PSL_TName].data(), toks[PSL_TName].size());
                     
-                    l.tStart    = stoi(toks[PSL_TStart]);
-                    l.tEnd      = stoi(toks[PSL_TEnd]);
-                    l.tSize     = stoi(toks[PSL_TSize]);
+                    l.tStart    = s2i(toks[PSL_TStart]);
+                    l.tEnd      = s2i(toks[PSL_TEnd]);
+                    l.tSize     = s2i(toks[PSL_TSize]);
                     
-                    l.qStart    = stoi(toks[PSL_QStart]);
-                    l.qEnd      = stoi(toks[PSL_QEnd]);
-                    l.qSize     = stoi(toks[PSL_QSize]);
+                    l.qStart    = s2i(toks[PSL_QStart]);
+                    l.qEnd      = s2i(toks[PSL_QEnd]);
+                    l.qSize     = s2i(toks[PSL_QSize]);
                     
-                    l.match     = stoi(toks[PSL_Matches]);
-                    l.mismatch  = stoi(toks[PSL_MisMatches]);
+                    l.match     = s2i(toks[PSL_Matches]);
+                    l.mismatch  = s2i(toks[PSL_MisMatches]);
                     
-                    l.qGap      = stoi(toks[PSL_QGap_Bases]);
-                    l.tGap      = stoi(toks[PSL_TGap_Bases]);
+                    l.qGap      = s2i(toks[PSL_QGap_Bases]);
+                    l.tGap      = s2i(toks[PSL_TGap_Bases]);
                     
-                    l.qGapCount = stoi(toks[PSL_QGap_Count]);
-                    l.tGapCount = stoi(toks[PSL_TGap_Count]);
+                    l.qGapCount = s2i(toks[PSL_QGap_Count]);
+                    l.tGapCount = s2i(toks[PSL_TGap_Count]);
                     
                     f(l, p);
                 }
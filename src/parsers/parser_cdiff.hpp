@@ -10,6 +10,7 @@
 #include "data/dtest.hpp"
 #include "data/reader.hpp"
 #include "data/tokens.hpp"
+#include "data/convert.hpp"
 #include "stats/analyzer.hpp"
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -41,13 +42,13 @@ namespace Anaquin
 
         static bool isTracking(const Reader &r)
         {
-            std::string line;
-            std::vector<Token> toks;
+            boost::string_ref line;
+            Fields toks;
             
             // Read the header
-            if (r.nextLine(line))
+            if (r.nextView(line))
             {
-                Tokens::split(line, "\t", toks);
+                toks.split(line, '\t');
                 
                 if (toks.size() == 14               &&
                     toks[0]  == "test_id"           &&
@@ -87,10 +88,10 @@ namespace Anaquin
             Data t;
             ParserProgress p;
             
-            std::string line;
-            std::vector<std::string> toks, temp;
+            Fields toks;
+            boost::string_ref line;
             
-            while (i.nextLine(line))
+            while (i.nextView(line))
             {
                 p.i++;
                 
@@ -99,22 +100,22 @@ namespace Anaquin
                     continue;
                 }
                 
-                Tokens::split(line, "\t", toks);
+                toks.split(line, '\t');
 
-                t.gID    = toks[FGeneID];
-                t.iID    = toks[FTestID];
-                t.status = tok2Status.at(toks[FStatus]);
-                t.logF_   = stof(toks[FLogFold]);
-                t.stats  = stof(toks[FTestStats]);
+                t.gID    = toks[FGeneID].to_string();
+                t.iID    = toks[FTestID].to_string();
+                t.status = tok2Status.at(toks[FStatus].to_string());
+                t.logF_   = s2f(toks[FLogFold]);
+                t.stats  = s2f(toks[FTestStats]);
                 
                 // Eg: chrIS:1082119-1190836
-                Tokens::split(toks[FLocus], ":", temp);
+                const auto locus = toks[FLocus];
                 
                 // Eg: chrIS
-                t.cID = temp[0];
+                t.cID = locus.substr(0, locus.find(':')).to_string();
                 
-                t.p = stold(toks[FPValue]);
-                t.q = stold(toks[FQValue]);
+                t.p = s2ld(toks[FPValue]);
+                t.q = s2ld(toks[FQValue]);
                 
                 if (t.status != DiffTest::Status::NotTested)
                 {
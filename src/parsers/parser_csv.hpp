@@ -4,23 +4,27 @@
 #include <vector>
 #include <functional>
 #include "data/reader.hpp"
+#include "data/tokens.hpp"
 #include "parsers/parser.hpp"
 
 namespace Anaquin
 {
     struct ParserCSV
     {
-        typedef std::vector<std::string> Data;
+        // Fields of the line, only valid until the function returns
+        typedef Fields Data;
 
-        template <typename F> static void parse(const Reader &r, F f, const std::string &delim = ",")
+        template <typename F> static void parse(const Reader &r, F f, char delim = ',')
         {
             protectParse("CSV format", [&]()
             {
                 ParserProgress p;
-                std::vector<std::string> tokens;
+                Fields tokens;
+                boost::string_ref line;
                 
-                while (r.nextTokens(tokens, delim))
+                while (r.nextView(line))
                 {
+                    tokens.split(line, delim);
                     f(tokens, p);
                     p.i++;
                 }
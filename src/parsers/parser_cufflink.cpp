@@ -29,19 +29,21 @@ void ParserCufflink::parse(const FileName &file, std::function<void (const Parse
     ParserCufflink::Data t;
     ParserProgress p;
     
-    std::string line;
-    std::vector<std::string> temp, tokens;
+    Fields tokens;
+    boost::string_ref line;
     
-    while (i.nextLine(line))
+    while (i.nextView(line))
     {
         p.i++;
-        Tokens::split(line, "\t", tokens);
+        tokens.split(line, '\t');
 
         /*
          * tracking_id  code  nearest_ref  gene_id  gene_short  tss_id  locus  length  coverage  FPKM  FPKM_conf_lo  FPKM_conf_hi  FPKM_status
          */
 
-        if (!mapper.count(tokens[T_Status]))
+        const auto status = mapper.find(tokens[T_Status].to_string());
+
+        if (status == mapper.end())
         {
             continue;
         }
@@ -52,21 +54,22 @@ void ParserCufflink::parse(const FileName &file, std::function<void (const Parse
         assert(!tokens[T_FPKM_HI].empty());
         assert(!tokens[T_Status].empty());
 
-        t.id  = tokens[T_GeneID];
-        t.tID = tokens[T_TrackID];
+        t.id.assign(tokens[T_GeneID].data(), tokens[T_GeneID].size());
+        t.tID.assign(tokens[T_TrackID].data(), tokens[T_TrackID].size());
 
         // Eg: chrIS:1082119-1190836
-        Tokens::split(tokens[T_Locus], ":", temp);
+        const auto locus = tokens[T_Locus];
+        const auto j = locus.find(':');
         
-        t.cID = temp[0];
+        t.cID.assign(locus.data(), j);
         
         // Eg: 1082119-1190836
-        Tokens::split(std::string(temp[1]), "-", temp);
+        const auto range = locus.substr(j + 1);
 
         // Eg: 1082119, 1190836
-        t.l = Locus(stod(temp[0]), stod(temp[1]));
+        t.l = Locus(s2i(range), s2i(range.substr(range.find('-') + 1)));
         
-        t.status = mapper.at(tokens[T_Status]);
+        t.status = status->second;
         
         try
         {
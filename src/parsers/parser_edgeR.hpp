@@ -19,12 +19,12 @@ namespace Anaquin
 
         static bool isEdgeR(const Reader &r)
         {
-            std::string line;
-            std::vector<Token> toks;
+            boost::string_ref line;
+            Fields toks;
             
-            if (r.nextLine(line))
+            if (r.nextView(line))
             {
-                Tokens::split(line, ",", toks);
+                toks.split(line, ',');
 
                 if (toks.size() == 4  && toks[0].empty() && toks[1] == "logFC" && toks[2] == "logCPM" && toks[3] == "PValue")
                 {
@@ -42,21 +42,21 @@ namespace Anaquin
             Reader r(file);
             ParserProgress p;
             
-            std::string line;
-            std::vector<std::string> toks;
+            boost::string_ref line;
+            Fields toks;
             
             // We'll need it for checking sequin genes
             const auto &s = Standard::instance().r_rna;
             
-            while (r.nextLine(line))
+            while (r.nextView(line))
             {
-                Tokens::split(line, ",", toks);
+                toks.split(line, ',');
                 
                 DiffTest t;
                 
                 if (p.i)
                 {
-                    t.gID = toks[Field::Name];
+                    t.gID = toks[Field::Name].to_string();
 
                     /*
                      * edgeR wouldn't give the chromosome name, only the name of the gene would be given.
@@ -87,7 +87,7 @@ namespace Anaquin
                         t.samp2 = NAN;
                         
                         // Probability under the null hypothesis
-                        t.p = stold(toks[Field::PValue]);
+                        t.p = s2ld(toks[Field::PValue]);
                     }
                     
                     f(t, p);
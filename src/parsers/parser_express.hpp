@@ -30,13 +30,13 @@ namespace Anaquin
 
         static bool isExpress(const Reader &r)
         {
-            std::string line;
-            std::vector<Token> toks;
+            boost::string_ref line;
+            Fields toks;
 
             // Read the header
-            if (r.nextLine(line))
+            if (r.nextView(line))
             {
-                Tokens::split(line, "\t", toks);
+                toks.split(line, '\t');
 
                 if (toks.size() == 4 &&
                     toks[0] == "ChrID" &&
@@ -54,26 +54,26 @@ namespace Anaquin
         template <typename F> static void parse(const Reader &r, bool shouldGene, F f)
         {
             ParserProgress p;
-            std::string line;
-            std::vector<Token> toks;
+            boost::string_ref line;
+            Fields toks;
             
-            while (r.nextLine(line))
+            while (r.nextView(line))
             {
-                Tokens::split(line, "\t", toks);
+                toks.split(line, '\t');
                 Data x;
 
                 if (p.i)
                 {
                     if (shouldGene)
                     {
-                        x.id = toks[Field::GeneID];
+                        x.id = toks[Field::GeneID].to_string();
                     }
                     else
                     {
-                        x.id = toks[Field::IsoID];
+                        x.id = toks[Field::IsoID].to_string();
                     }
                     
-                    x.cID   = toks[Field::ChrID];
+                    x.cID   = toks[Field::ChrID].to_string();
                     x.abund = ss2ld(toks[Field::Abund]);
                     
                     f(x, p);
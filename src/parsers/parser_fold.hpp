@@ -34,13 +34,13 @@ namespace Anaquin
         
         static bool isDiff(const Reader &r)
         {
-            std::string line;
-            std::vector<Token> toks;
+            boost::string_ref line;
+            Fields toks;
             
             // Read the header
-            if (r.nextLine(line))
+            if (r.nextView(line))
             {
-                Tokens::split(line, "\t", toks);
+                toks.split(line, '\t');
                 
                 if (toks.size() == 10      &&
                     toks[0] == "ChrID"     &&
@@ -67,19 +67,19 @@ namespace Anaquin
             
             Reader rr(file);
             ParserProgress p;
-            std::vector<Token> toks;
+            Fields toks;
 
-            std::string line;
+            boost::string_ref line;
             
-            while (rr.nextLine(line))
+            while (rr.nextView(line))
             {
-                Tokens::split(line, "\t", toks);
+                toks.split(line, '\t');
                 Data x;
 
                 if (p.i)
                 {
-                    x.gID    = toks[Field::GeneID]    != "-" ? toks[Field::GeneID]    : "";
-                    x.iID    = toks[Field::IsoformID] != "-" ? toks[Field::IsoformID] : "";
+                    x.gID    = toks[Field::GeneID]    != "-" ? toks[Field::GeneID].to_string()    : "";
+                    x.iID    = toks[Field::IsoformID] != "-" ? toks[Field::IsoformID].to_string() : "";
                     x.p      = ss2ld(toks[Field::PValue]);
                     x.q      = ss2ld(toks[Field::QValue]);
                     x.mean   = s2d(toks[Field::Mean]);
@@ -89,7 +89,7 @@ namespace Anaquin
                     x.samp2  = s2d(toks[Field::Sample2]);
 
                     // Eg: DESeq2 wouldn't give the chromoname name
-                    x.cID = toks[Field::ChrID];
+                    x.cID = toks[Field::ChrID].to_string();
                     
                     if (x.cID == "-")
                     {
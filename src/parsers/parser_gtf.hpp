@@ -1,10 +1,12 @@
 #ifndef PARSER_GTF_HPP
 #define PARSER_GTF_HPP
 
+#include <cctype>
 #include "data/tokens.hpp"
 #include "data/reader.hpp"
 #include "data/convert.hpp"
 #include "stats/analyzer.hpp"
+#include <boost/utility/string_ref.hpp>
 
 extern bool __hack__;
 
@@ -34,16 +36,53 @@ namespace Anaquin
             double fpkm = NAN;
         };
         
-        template <typename F> static void parse(const Reader &r, F f)
+        /*
+         * Single pass over the attribute column, eg: "gene_id "R_5_3"; transcript_id "R_5_3_R";". The
+         * function is called with the name and the value (quotes removed) of each attribute, nothing
+         * is copied. Attributes not in the form of "name value" are skipped.
+         */
+
+        template <typename F> static void attrs(boost::string_ref x, F f)
         {
-            std::map<std::string, RNAFeature> mapper =
+            while (!x.empty())
             {
-                { "exon",       Exon },
-                { "gene",       Gene },
-                { "transcript", Transcript }
-            };
-            
-            std::string line;
+                auto i = x.find(';');
+                auto a = x.substr(0, i);
+
+                x = i == boost::string_ref::npos ? boost::string_ref() : x.substr(i + 1);
+
+                // Trim the attribute
+                while (!a.empty() && std::isspace(static_cast<unsigned char>(a.front()))) { a.remove_prefix(1); }
+                while (!a.empty() && std::isspace(static_cast<unsigned char>(a.back())))  { a.remove_suffix(1); }
+
+                const auto j = a.find(' ');
+
+                if (a.empty() || j == boost::string_ref::npos)
+                {
+                    continue;
+                }
+
+                const auto name = a.substr(0, j);
+                auto val = a.substr(j + 1);
+
+                // Eg: values with spaces
+                if (val.find(' ') != boost::string_ref::npos)
+                {
+                    continue;
+                }
+
+                if (!val.empty() && val.front() == '\"') { val.remove_prefix(1); }
+                if (!val.empty() && val.back()  == '\"') { val.remove_suffix(1); }
+
+                f(name, val);
+            }
+        }
+
+        // The function is called with the feature and its line, the line is valid until the function returns
+
+        template <typename F> static void parse(const Reader &r, F f)
+        {
+            boost::string_ref line;
             Data x;
             
             /*
@@ -62,12 +101,21 @@ namespace Anaquin
              */
             
             ParserProgress p;
-            
-            std::vector<std::string> opts;
-            std::vector<std::string> toks;
-            std::vector<std::string> nameVal;
-            
-            while (r.nextLine(line))
+            Fields toks;
+
+            auto toBase = [&](boost::string_ref x)
+            {
+                try
+                {
+                    return static_cast<Base>(s2i(x));
+                }
+                catch (...)
+                {
+                    throw std::runtime_error("File: " + r.src() + ". Invalid position: [" + x.to_string() + "]. Line: " + line.to_string());
+                }
+            };
+
+            while (r.nextView(line))
             {
                 if (__hack__)
                 {
@@ -75,23 +123,37 @@ namespace Anaquin
                 }
                 
                 p.i++;
-                boost::split(toks, line, boost::is_any_of("\t"));
-                
+
                 // Empty line? Unknown feature such as mRNA?
-                if (toks.size() == 1 || !mapper.count(toks[2]))
+                if (toks.split(line, '\t') < 9)
                 {
                     continue;
                 }
-                
-                x.cID  = toks[0];
-                x.type = mapper[toks[2]];
+                else if (toks[2] == "exon")
+                {
+                    x.type = Exon;
+                }
+                else if (toks[2] == "gene")
+                {
+                    x.type = Gene;
+                }
+                else if (toks[2] == "transcript")
+                {
+                    x.type = Transcript;
+                }
+                else
+                {
+                    continue;
+                }
+
+                x.cID.assign(toks[0].data(), toks[0].size());
 
-                x.l.start = stoi(toks[3]);
-                x.l.end   = stoi(toks[4]);
+                x.l.start = toBase(toks[3]);
+                x.l.end   = toBase(toks[4]);
 
                 if (toks[6] != "+" && toks[6] != "-" && toks[6] != ".")
                 {
-                    throw std::runtime_error("File: " + r.src() + ". Invalid strand: [" + toks[6] + "]. Line: " + line );
+                    throw std::runtime_error("File: " + r.src() + ". Invalid strand: [" + toks[6].to_string() + "]. Line: " + line.to_string());
                 }
 
                 if (toks[6] == ".")
@@ -103,39 +165,21 @@ namespace Anaquin
                     x.str = toks[6] == "+" ? Strand::Forward : Strand::Backward;
                 }
 
-                /*
-                 * Eg: "gene_id "R_5_3"; transcript_id "R_5_3_R";"
-                 */
-                
-                boost::split(opts, toks[8], boost::is_any_of(";"));
-                
-                for (auto option : opts)
+                attrs(toks[8], [&](boost::string_ref name, boost::string_ref val)
                 {
-                    if (!option.empty())
+                    if (name == "gene_id")
                     {
-                        boost::trim(option);
-                        boost::split(nameVal, option, boost::is_any_of(" "));
-                        
-                        if (nameVal.size() == 2)
-                        {
-                            // Make sure the silly characters are removed
-                            nameVal[1].erase(std::remove(nameVal[1].begin(), nameVal[1].end(), '\"'), nameVal[1].end());
-                            
-                            if (nameVal[0] == "gene_id")
-                            {
-                                x.gID = nameVal[1];
-                            }
-                            else if (nameVal[0] == "transcript_id")
-                            {
-                                x.tID = nameVal[1];
-                            }
-                            else if (nameVal[0] == "FPKM")
-                            {
-                                x.fpkm = s2d(nameVal[1]);
-                            }
-                        }
+                        x.gID.assign(val.data(), val.size());
                     }
-                }
+                    else if (name == "transcript_id")
+                    {
+                        x.tID.assign(val.data(), val.size());
+                    }
+                    else if (name == "FPKM")
+                    {
+                        x.fpkm = s2d(val);
+                    }
+                });
 
                 f(x, line, p);
             }            
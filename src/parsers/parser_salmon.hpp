@@ -33,13 +33,13 @@ namespace Anaquin
         
         static bool isSalmon(const Reader &r)
         {
-            std::string line;
-            std::vector<Token> toks;
+            boost::string_ref line;
+            Fields toks;
             
             // Read the header
-            if (r.nextLine(line))
+            if (r.nextView(line))
             {
-                Tokens::split(line, "\t", toks);
+                toks.split(line, '\t');
                 
                 if (toks.size() == 5              &&
                     toks[0]  == "Name"            &&
@@ -64,19 +64,19 @@ namespace Anaquin
                 Data d;
                 ParserProgress p;
                 
-                Line line;
-                std::vector<Token> toks;
+                boost::string_ref line;
+                Fields toks;
                 
-                while (rr.nextLine(line))
+                while (rr.nextView(line))
                 {
                     if (p.i++ == 0)
                     {
                         continue;
                     }
                     
-                    Tokens::split(line, "\t", toks);
+                    toks.split(line, '\t');
                     
-                    d.id = toks[Name];
+                    d.id.assign(toks[Name].data(), toks[Name].size());
                     
                     //if (r.findTrans(ChrIS, d.id))
                     {
@@ -1,4 +1,5 @@
 #include <htslib/sam.h>
+#include "data/intern.hpp"
 #include "tools/samtools.hpp"
 #include "parsers/parser_sam.hpp"
 #include <boost/algorithm/string/predicate.hpp>
@@ -109,6 +110,36 @@ bool ParserSAM::Data::nextCigar(Locus &l, bool &spliced)
     return false;
 }
 
+std::set<ChrID> ParserSAM::header(const FileName &file)
+{
+    auto f = sam_open(file.c_str(), "r");
+    
+    if (!f)
+    {
+        throw std::runtime_error("Failed to open: " + file);
+    }
+
+    auto h = sam_hdr_read(f);
+
+    if (!h)
+    {
+        sam_close(f);
+        throw std::runtime_error("Failed to read the header: " + file);
+    }
+
+    std::set<ChrID> x;
+
+    for (auto i = 0; i < h->n_targets; i++)
+    {
+        x.insert(h->target_name[i]);
+    }
+
+    bam_hdr_destroy(h);
+    sam_close(f);
+
+    return x;
+}
+
 void ParserSAM::parse(const FileName &file, Functor x, bool details)
 {
     auto f = sam_open(file.c_str(), "r");
@@ -121,12 +152,22 @@ void ParserSAM::parse(const FileName &file, Functor x, bool details)
     auto t = bam_init1();
     auto h = sam_hdr_read(f);
 
+    // Chromosomes interned once, rather than copied from the header for every read
+    std::vector<IStr> cIDs;
+
+    for (auto i = 0; i < h->n_targets; i++)
+    {
+        cIDs.push_back(IStr(h->target_name[i]));
+    }
+
     Info info;
     Data align;
 
     while (sam_read1(f, h, t) >= 0)
     {
-        info.length = h->target_len[t->core.tid];
+        const auto hasCID = t->core.tid >= 0;
+
+        info.length = hasCID ? h->target_len[t->core.tid] : 0;
 
         align.mapped = false;
         align.name   = bam_get_qname(t);
@@ -140,8 +181,6 @@ void ParserSAM::parse(const FileName &file, Functor x, bool details)
         align.mapq = t->core.qual;
         align.flag = t->core.flag;
         
-        const auto hasCID = t->core.tid >= 0;
-        
         if (details)
         {
             align.seq    = bam2seq(t);
@@ -187,11 +226,17 @@ void ParserSAM::parse(const FileName &file, Functor x, bool details)
 
         if (hasCID)
         {
-            align.cID = std::string(h->target_name[t->core.tid]);
+            // Alignments are usually sorted, so the name is only copied when the chromosome changes
+            if (align._cID != cIDs[t->core.tid])
+            {
+                align._cID = cIDs[t->core.tid];
+                align.cID  = align._cID.str();
+            }
         }
         else
         {
-            align.cID = "*";
+            align._cID = IStr();
+            align.cID  = "*";
             align.l.start = 0;
             align.l.end = 0;
         }
@@ -1,6 +1,7 @@
 #ifndef PARSER_SAM_HPP
 #define PARSER_SAM_HPP
 
+#include "data/intern.hpp"
 #include "data/alignment.hpp"
 #include "stats/analyzer.hpp"
 #include "parsers/parser.hpp"
@@ -46,15 +47,23 @@ namespace Anaquin
                 inline void *b() const { return _b; }
                 inline void *h() const { return _h; }
 
+                // Same as cID but interned, empty for an unmapped read without a chromosome
+                inline const IStr &iCID() const { return _cID; }
+
             private:
             
                 mutable int _i, _n;
 
+                IStr _cID;
+
                 void *_b;
                 void *_h;
         };
         
         static bool isBAM(const Reader &);
+
+        // Chromosomes in the header (@SQ), nothing else is read
+        static std::set<ChrID> header(const FileName &);
         
         typedef std::function<void (Data &, const Info &)> Functor;
         
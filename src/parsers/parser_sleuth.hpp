@@ -4,6 +4,7 @@
 #include "data/dtest.hpp"
 #include "data/tokens.hpp"
 #include "data/reader.hpp"
+#include "data/convert.hpp"
 #include "data/standard.hpp"
 #include "stats/analyzer.hpp"
 
@@ -30,13 +31,13 @@ namespace Anaquin
 
         static bool isSleuth(const Reader &r)
         {
-            std::string line;
-            std::vector<Token> toks;
+            boost::string_ref line;
+            Fields toks;
             
             // Read the header
-            if (r.nextLine(line))
+            if (r.nextView(line))
             {
-                Tokens::split(line, ",", toks);
+                toks.split(line, ',');
                 
                 if (toks.size() == 11             &&
                     toks[0]  == "target_id"       &&
@@ -64,18 +65,18 @@ namespace Anaquin
             
             ParserProgress p;
             
-            std::string line;
-            std::vector<std::string> toks;
+            boost::string_ref line;
+            Fields toks;
 
-            while (r.nextLine(line))
+            while (r.nextView(line))
             {
-                Tokens::split(line, ",", toks);
+                toks.split(line, ',');
                 
                 Data t;
                 
                 if (p.i)
                 {
-                    t.iID = toks[Field::TargetID];
+                    t.iID = toks[Field::TargetID].to_string();
                     
                     // Can we match the isoform to sequins?
                     auto isChrIS = ref.match(t.iID);
@@ -91,19 +92,19 @@ namespace Anaquin
                     {
                         t.status = DiffTest::Status::Tested;
                         
-                        t.mean = stod(toks[Field::MeanObs]);
+                        t.mean = s2d(toks[Field::MeanObs]);
                         
                         // Measured log-fold change
-                        t.logF_ = stod(toks[Field::B]);
+                        t.logF_ = s2d(toks[Field::B]);
                         
                         // Standard error for the log-fold change
-                        t.logFSE = stod(toks[Field::SE_B]);
+                        t.logFSE = s2d(toks[Field::SE_B]);
                         
                         // Probability under the null hypothesis
-                        t.p = stold(toks[Field::PValue]);
+                        t.p = s2ld(toks[Field::PValue]);
                         
                         // Probability controlled for multi-testing
-                        t.q = stold(toks[Field::QValue]);
+                        t.q = s2ld(toks[Field::QValue]);
                     }
                     
                     f(t, p);
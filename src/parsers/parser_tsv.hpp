@@ -3,6 +3,7 @@
 
 #include "data/tokens.hpp"
 #include "data/reader.hpp"
+#include "data/convert.hpp"
 #include "parsers/parser.hpp"
 
 namespace Anaquin
@@ -39,11 +40,11 @@ namespace Anaquin
         {
             try
             {
-                std::string line;
-                r.nextLine(line);
+                boost::string_ref line;
+                r.nextView(line);
                 
-                std::vector<std::string> toks;
-                Tokens::split(line, "\t", toks);
+                Fields toks;
+                toks.split(line, '\t');
                 
                 if (toks.size() != 9 &&
                     toks[0] != "#Contig name" &&
@@ -86,22 +87,22 @@ namespace Anaquin
             TSV t;
             ParserProgress p;
             
-            std::string line;
-            std::vector<std::string> toks;
+            boost::string_ref line;
+            Fields toks;
             
-            while (r.nextLine(line))
+            while (r.nextView(line))
             {
                 if (p.i++ == 0)
                 {
                     continue;
                 }
                 
-                Tokens::split(line, "\t", toks);
+                toks.split(line, '\t');
                 
-                t.id   = toks[TSVField::Contig];
-                t.dep  = stoi(toks[TSVField::ModeKMer]);
-                t.kmer = stoi(toks[TSVField::KMerObs]);
-                t.klen = stoi(toks[TSVField::ContigLength]);
+                t.id.assign(toks[TSVField::Contig].data(), toks[TSVField::Contig].size());
+                t.dep  = s2i(toks[TSVField::ModeKMer]);
+                t.kmer = s2i(toks[TSVField::KMerObs]);
+                t.klen = s2i(toks[TSVField::ContigLength]);
                 
                 f(t, p);
             }
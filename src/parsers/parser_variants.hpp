@@ -27,17 +27,17 @@ namespace Anaquin
 
         typedef CalledVariant Data;
 
-        typedef std::function<void(const Data &, const ParserProgress &)> Functor;
+        typedef std::function<void(const Data &, ParserProgress &)> Functor;
 
         static bool isVariant(const Reader &r)
         {
-            std::string line;
-            std::vector<Token> toks;
+            boost::string_ref line;
+            Fields toks;
             
             // Read the header
-            if (r.nextLine(line))
+            if (r.nextView(line))
             {
-                Tokens::split(line, "\t", toks);
+                toks.split(line, '\t');
                 
                 if (toks.size() == 10      &&
                     toks[0]  == "ChrID"    &&
@@ -63,22 +63,22 @@ namespace Anaquin
             Data d;
             ParserProgress p;
             
-            Line line;
-            std::vector<Token> toks;
+            boost::string_ref line;
+            Fields toks;
 
-            while (r.nextLine(line))
+            while (!p.stopped && r.nextView(line))
             {
                 if (p.i++ == 0)
                 {
                     continue;
                 }
                 
-                Tokens::split(line, "\t", toks);
+                toks.split(line, '\t');
                 
-                d.cID = toks[Chrom];
+                d.cID.assign(toks[Chrom].data(), toks[Chrom].size());
 
                 // Always start and end at the same position
-                d.l = Locus(stod(toks[Position]), stod(toks[Position]));
+                d.l = Locus(s2i(toks[Position]), s2i(toks[Position]));
 
                 d.qualR = s2d(toks[QualR]);
                 d.qualV = s2d(toks[QualV]);
@@ -101,12 +101,12 @@ namespace Anaquin
                     continue;
                 }
                 
-                d.ref = toks[Ref];
-                d.alt = toks[Alt];
+                d.ref.assign(toks[Ref].data(), toks[Ref].size());
+                d.alt.assign(toks[Alt].data(), toks[Alt].size());
                 
                 try
                 {
-                    d.p = stold(toks[PValue]);
+                    d.p = s2ld(toks[PValue]);
                 }
                 catch (...)
                 {
@@ -1,7 +1,6 @@
 #include <map>
 #include "tools/errors.hpp"
 #include "parsers/parser_varscan.hpp"
-#include <boost/algorithm/string.hpp>
 
 using namespace Anaquin;
 
@@ -63,12 +62,12 @@ namespace Somatic
 
 bool ParserVarScan::isPileup(const Reader &r)
 {
-    std::string line;
-    std::vector<Token> toks;
+    Fields toks;
+    boost::string_ref line;
     
-    if (r.nextLine(line))
+    if (r.nextView(line))
     {
-        Tokens::split(line, "\t", toks);
+        toks.split(line, '\t');
         
         if (toks.size() == 19         &&
             toks[0]  == "Chrom"       &&
@@ -100,12 +99,12 @@ bool ParserVarScan::isPileup(const Reader &r)
 
 bool ParserVarScan::isSomatic(const Reader &r)
 {
-    std::string line;
-    std::vector<Token> toks;
+    Fields toks;
+    boost::string_ref line;
     
-    if (r.nextLine(line))
+    if (r.nextView(line))
     {
-        Tokens::split(line, "\t", toks);
+        toks.split(line, '\t');
         
         if (toks.size() == 23                 &&
             toks[0]  == "chrom"               &&
@@ -143,41 +142,43 @@ void ParserVarScan::parseSomatic(const Reader &r, Functor f)
 {
     using Somatic::Field;
     
+    static const std::map<std::string, Variant::Status> s2s =
+    {
+        { "LOH",      Variant::Status::LOH },
+        { "Somatic",  Variant::Status::Somatic },
+        { "Germline", Variant::Status::Germline },
+    };
+
     Data d;
     ParserProgress p;
     
-    Line line;
-    std::vector<Token> toks;
+    Fields toks;
+    boost::string_ref line;
     
-    while (r.nextLine(line))
+    while (!p.stopped && r.nextView(line))
     {
         if (p.i++ == 0)
         {
             continue;
         }
         
-        Tokens::split(line, "\t", toks);
+        toks.split(line, '\t');
         
-        d.cID = toks[Field::Chrom];
+        d.cID.assign(toks[Field::Chrom].data(), toks[Field::Chrom].size());
         
         // Always start and end at the same position
-        d.l = Locus(stod(toks[Field::Position]), stod(toks[Field::Position]));
+        d.l = Locus(s2i(toks[Field::Position]), s2i(toks[Field::Position]));
         
         d.allF = s2d(toks[Field::TumorVarFreq]);
         
-        const std::map<std::string, Variant::Status> s2s =
-        {
-            { "LOH",      Variant::Status::LOH },
-            { "Somatic",  Variant::Status::Somatic },
-            { "Germline", Variant::Status::Germline },
-        };
+        const auto status = s2s.find(toks[Field::SomaticStatus].to_string());
         
-        if (!s2s.count(toks[Field::SomaticStatus]))
+        if (status == s2s.end())
         {
-            A_THROW("Unknown variant status: " + toks[Field::SomaticStatus]);
+            A_THROW("Unknown variant status: " + toks[Field::SomaticStatus].to_string());
         }
         
-        d.status = s2s.at(toks[Field::SomaticStatus]);
+        d.status = status->second;
 
         const auto readR = s2d(toks[Field::TumorReads1]);
         const auto readV = s2d(toks[Field::TumorReads2]);
@@ -191,12 +192,12 @@ void ParserVarScan::parseSomatic(const Reader &r, Functor f)
             continue;
         }
         
-        d.ref = toks[Field::Ref];
-        d.alt = toks[Field::Var];
+        d.ref.assign(toks[Field::Ref].data(), toks[Field::Ref].size());
+        d.alt.assign(toks[Field::Var].data(), toks[Field::Var].size());
         
         try
         {
-            d.p = stold(toks[Field::SomaticPValue]);
+            d.p = s2ld(toks[Field::SomaticPValue]);
         }
         catch (...)
         {
@@ -216,22 +217,22 @@ void ParserVarScan::parsePile(const Reader &r, Functor f)
     Data d;
     ParserProgress p;
     
-    Line line;
-    std::vector<Token> toks;
+    Fields toks;
+    boost::string_ref line;
     
-    while (r.nextLine(line))
+    while (!p.stopped && r.nextView(line))
     {
         if (p.i++ == 0)
         {
             continue;
         }
         
-        Tokens::split(line, "\t", toks);
+        toks.split(line, '\t');
         
-        d.cID = toks[Field::Chrom];
+        d.cID.assign(toks[Field::Chrom].data(), toks[Field::Chrom].size());
         
         // Always start and end at the same position
-        d.l = Locus(stod(toks[Field::Position]), stod(toks[Field::Position]));
+        d.l = Locus(s2i(toks[Field::Position]), s2i(toks[Field::Position]));
         
         d.allF = s2d(toks[Field::VarFreq]);
         
@@ -258,19 +259,24 @@ void ParserVarScan::parsePile(const Reader &r, Functor f)
          * Is this an insertion?
          */
         
-        const auto isInsert = toks[Field::Cons].find("*/+") != std::string::npos;
-        const auto isDelete = toks[Field::Cons].find("*/-") != std::string::npos;
+        const auto isInsert = toks[Field::Cons].find("*/+") != boost::string_ref::npos;
+        const auto isDelete = toks[Field::Cons].find("*/-") != boost::string_ref::npos;
         
-        auto clean = [&](const std::string &s)
+        // The alleles joined together without the '*', '/', '-' and '+'
+        auto clean = [&](std::string &x, boost::string_ref a, boost::string_ref b)
         {
-            auto x = s;
-            
-            boost::replace_all(x, "*", "");
-            boost::replace_all(x, "/", "");
-            boost::replace_all(x, "-", "");
-            boost::replace_all(x, "+", "");
+            x.clear();
             
-            return x;
+            for (const auto &s : { a, b })
+            {
+                for (auto c : s)
+                {
+                    if (c != '*' && c != '/' && c != '-' && c != '+')
+                    {
+                        x.push_back(c);
+                    }
+                }
+            }
         };
         
         if (isInsert)
@@ -279,8 +285,8 @@ void ParserVarScan::parsePile(const Reader &r, Functor f)
              * Eg: A * /+CT	+CT
              */
             
-            d.ref = clean(toks[Field::Ref]);
-            d.alt = clean(toks[Field::Ref] + toks[Field::VarAllele]);
+            clean(d.ref, toks[Field::Ref], "");
+            clean(d.alt, toks[Field::Ref], toks[Field::VarAllele]);
         }
         else if (isDelete)
         {
@@ -288,13 +294,13 @@ void ParserVarScan::parsePile(const Reader &r, Functor f)
              * Eg: G * /-CTTCCTCTTTC CTTCCTCTTTC
              */
             
-            d.ref = clean(toks[Field::Ref] + toks[Field::VarAllele]);
-            d.alt = clean(toks[Field::Ref]);
+            clean(d.ref, toks[Field::Ref], toks[Field::VarAllele]);
+            clean(d.alt, toks[Field::Ref], "");
         }
         else
         {
-            d.ref = clean(toks[Field::Ref]);
-            d.alt = clean(toks[Field::VarAllele]);
+            clean(d.ref, toks[Field::Ref], "");
+            clean(d.alt, toks[Field::VarAllele], "");
         }
         
         A_ASSERT(d.ref.find('+') == std::string::npos);
@@ -302,7 +308,7 @@ void ParserVarScan::parsePile(const Reader &r, Functor f)
         
         try
         {
-            d.p = stold(toks[Field::PValue]);
+            d.p = s2ld(toks[Field::PValue]);
         }
         catch (...)
         {
@@ -13,7 +13,7 @@ namespace Anaquin
     {
         typedef CalledVariant Data;
 
-        typedef std::function<void(const Data &, const ParserProgress &)> Functor;
+        typedef std::function<void(const Data &, ParserProgress &)> Functor;
 
         static bool isVarScan(const Reader &r)
         {
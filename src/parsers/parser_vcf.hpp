@@ -31,17 +31,17 @@ namespace Anaquin
         
         template <typename F> static void parse(const Reader &r, F f)
         {
-            std::string line;
+            boost::string_ref line;
             
             Data d;
             ParserProgress p;
             
-            std::vector<std::string> t;
-            std::vector<std::string> infos;
-            std::vector<std::string> fields;
-            std::vector<std::string> formats;
+            Fields t;
+            Fields infos;
+            Fields fields;
+            Fields formats;
             
-            while (r.nextLine(line))
+            while (r.nextView(line))
             {
                 p.i++;
                 
@@ -49,24 +49,29 @@ namespace Anaquin
                 {
                     break;
                 }                
-                else if (line[0] == '#')
+                else if (line.empty() || line[0] == '#')
                 {
                     continue;
                 }
                 
-                Tokens::split(line, "\t", fields);
+                fields.split(line, '\t');
+                
+                if (fields.size() <= Field::Qual)
+                {
+                    throw std::runtime_error("File: " + r.src() + ". Invalid line: " + line.to_string());
+                }
                 
                 // Eg: chrIS
-                d.cID = fields[Field::Chrom];
+                d.cID.assign(fields[Field::Chrom].data(), fields[Field::Chrom].size());
                 
                 // Eg: D_1_3_R
-                d.id = fields[Field::ID];
+                d.id.assign(fields[Field::ID].data(), fields[Field::ID].size());
                 
                 // VCF has 1-based position
-                d.l.start = d.l.end = stod(fields[Field::Pos]);
+                d.l.start = d.l.end = s2i(fields[Field::Pos]);
                 
                 // Reference allele
-                d.ref = fields[Field::Ref];
+                d.ref.assign(fields[Field::Ref].data(), fields[Field::Ref].size());
                 
                 /*
                  * Additional information
@@ -74,9 +79,9 @@ namespace Anaquin
                  *    AF: allele frequency for each ALT allele in the same order as listed
                  */
                 
-                if (fields[Field::Info] != ".")
+                if (fields.size() > Field::Info && fields[Field::Info] != ".")
                 {
-                    Tokens::split(fields[Field::Info], ";", infos);
+                    infos.split(fields[Field::Info], ';');
                     
                     for (const auto &info : infos)
                     {
@@ -85,10 +90,10 @@ namespace Anaquin
                          *     AA=g;DP=132;HM2
                          */
                         
-                        Tokens::split(info, "=", t);
+                        t.split(info, '=');
                         
                         // Measured allele frequency
-                        if (t[0] == "AF") { d.allF = stof(t[1]); }
+                        if (t.size() > 1 && t[0] == "AF") { d.allF = s2f(t[1]); }
                     }
                 }
 
@@ -96,42 +101,35 @@ namespace Anaquin
                  * Anaquin doesn't support multi-alleles (because sequins don't have it)
                  */
                 
-                std::vector<Sequence> alts;
-                Tokens::split(fields[Field::Alt], ",", alts);
+                const auto alt = fields[Field::Alt].substr(0, fields[Field::Alt].find(','));
                 
                 // Ignore anything that is not really a variant
-                if ((d.alt = alts[0]) == ".")
+                if (alt == ".")
                 {
                     continue;
                 }
                 
+                d.alt.assign(alt.data(), alt.size());
                 d.qual = fields[Field::Qual] != "." ? s2d(fields[Field::Qual]) : NAN;
 
-                if (fields.size() > Field::Format)
+                if (fields.size() > Field::FormatData)
                 {
-                    Tokens::split(fields[Field::Format], ":", formats);
+                    formats.split(fields[Field::Format], ':');
                     
                     // Eg: 1/2:0,11,5:16:99:694,166,119,378,0,331
-                    Tokens::split(fields[Field::FormatData], ":", t);
+                    t.split(fields[Field::FormatData], ':');
                     
                     // Check all the format data...
-                    for (auto j = 0; j < t.size(); j++)
+                    for (auto j = 0u; j < t.size() && j < formats.size(); j++)
                     {
                         if (formats[j] == "AD")
                         {
-                            std::vector<std::string> toks;
-                            Tokens::split(t[j], ",", toks);
+                            // Eg: 0,11
+                            const auto i = t[j].find(',');
+                            const auto v = i == boost::string_ref::npos ? t[j] : t[j].substr(i + 1);
                             
-                            if (toks.size() == 1)
-                            {
-                                d.readR = s2d(toks[0]);
-                                d.readV = s2d(toks[0]);
-                            }
-                            else
-                            {
-                                d.readR = s2d(toks[0]);
-                                d.readV = s2d(toks[1]);
-                            }
+                            d.readR = s2d(t[j].substr(0, i));
+                            d.readV = s2d(v.substr(0, v.find(',')));
                         }
                         else if (formats[j] == "DP")
                         {
@@ -34,8 +34,7 @@ namespace Anaquin
                 
                 for (const auto &inter : i.second.data())
                 {
-                    const auto &l = inter.second.l();
-                    x.add(Interval(l.key(), l));
+                    x.add(Interval(inter.second.id(), inter.second.l()));
                 }
 
                 stats.inters[i.first] = x;
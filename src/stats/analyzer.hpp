@@ -51,7 +51,7 @@ namespace Anaquin
         });
     }
     
-    template <typename T1, typename T2> T2 sum(const std::map<T1, T2> &x)
+    template <typename T1, typename T2, typename C, typename A> T2 sum(const std::map<T1, T2, C, A> &x)
     {
         return std::accumulate(std::begin(x), std::end(x), T2(), [](T2 c, const std::pair<T1, T2>& p)
         {
@@ -224,6 +224,21 @@ namespace Anaquin
         double fuzzy;
     };
 
+    struct WindowOptions : public AnalyzerOptions
+    {
+        // Size of the genome-wide coverage windows, zero for no windows
+        Base window = 0;
+    };
+
+    struct FPReadOptions : public AnalyzerOptions
+    {
+        // Stream the names of FP reads to a compressed file
+        bool fpStream = false;
+
+        // Keep a sample of FP read names, zero for none
+        Counts fpSample = 0;
+    };
+
     struct ReportOptions : public AnalyzerOptions
     {
         FileName mix;
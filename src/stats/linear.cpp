@@ -4,6 +4,128 @@
 
 using namespace Anaquin;
 
+static double logged(double v, bool shouldLog)
+{
+    return shouldLog ? (v ? log2(v) : 0) : v;
+}
+
+void SequinStats::Moments::add(double x, double y)
+{
+    n++;
+    
+    const auto dx = x - mx;
+    const auto dy = y - my;
+    
+    mx += dx / n;
+    my += dy / n;
+    
+    sxx += dx * (x - mx);
+    syy += dy * (y - my);
+    sxy += dx * (y - my);
+}
+
+void SequinStats::Moments::remove(double x, double y)
+{
+    assert(n);
+    
+    if (n == 1)
+    {
+        *this = Moments();
+        return;
+    }
+    
+    // Means before the point was added
+    const auto px = mx - (x - mx) / (n - 1);
+    const auto py = my - (y - my) / (n - 1);
+    
+    sxx -= (x - px) * (x - mx);
+    syy -= (y - py) * (y - my);
+    sxy -= (x - px) * (y - my);
+    
+    mx = px;
+    my = py;
+    n--;
+}
+
+void SequinStats::update(double x, double y, bool add)
+{
+    // Only the points used for the regression
+    if (isnan(x) || isnan(y))
+    {
+        return;
+    }
+    
+    /*
+     * Both transformations are kept as we don't know which one will be fitted. Zero is logged as zero.
+     * Negative values can't be logged, they're counted rather than added to the moments (otherwise
+     * it'd be NaN for good) and the log-transformation can't be fitted while there's any.
+     */
+    
+    const auto lx = logged(x, true);
+    const auto ly = logged(y, true);
+    const auto ok = !isnan(lx) && !isnan(ly);
+    
+    if (add)
+    {
+        _raw.add(x, y);
+        
+        if (ok)
+        {
+            _log.add(lx, ly);
+        }
+        else
+        {
+            _nLog++;
+        }
+    }
+    else
+    {
+        _raw.remove(x, y);
+        
+        if (ok)
+        {
+            _log.remove(lx, ly);
+        }
+        else
+        {
+            _nLog--;
+        }
+    }
+}
+
+void SequinStats::add(const SequinID &id, double x, double y)
+{
+    const auto i = _index.find(id);
+    
+    if (i != _index.end())
+    {
+        update(_x[i->second], _y[i->second], false);
+        
+        _x[i->second] = x;
+        _y[i->second] = y;
+    }
+    else
+    {
+        _index[id] = _ids.size();
+        
+        _ids.push_back(id);
+        _x.push_back(x);
+        _y.push_back(y);
+    }
+
+    update(x, y, true);
+}
+
+void SequinStats::sum(const SequinID &id, double x, double y)
+{
+    const auto i = _index.at(id);
+    assert(_x[i] == x);
+    
+    update(_x[i], _y[i], false);
+    _y[i] += y;
+    update(_x[i], _y[i], true);
+}
+
 Limit SequinStats::limitQuant() const
 {
     Limit limit;
@@ -24,20 +146,13 @@ SequinStats::Data SequinStats::data(bool shouldLog) const
 {
     Data r;
     
-    auto f = [&](double v)
-    {
-        // Don't log zero...
-        assert(!shouldLog || v);
-        
-        return shouldLog ? (v ? log2(v) : 0) : v;
-    };
-    
     for (const auto &p : *this)
     {
+        // Zero is logged as zero
         if (!isnan(p.second.x) && !isnan(p.second.y))
         {
-            const auto x = f(p.second.x);
-            const auto y = f(p.second.y);
+            const auto x = logged(p.second.x, shouldLog);
+            const auto y = logged(p.second.y, shouldLog);
             
             r.x.push_back(x);
             r.y.push_back(y);
@@ -51,33 +166,50 @@ SequinStats::Data SequinStats::data(bool shouldLog) const
     return r;
 }
 
+/*
+ * The model is computed from the sufficient statistics, the results are the same as SS::linearModel()
+ * on data() (including when the degree of freedom for the error is zero). SS::linearModel() gives
+ * NaN if a negative value is logged, so does this.
+ */
+
 LinearModel SequinStats::linear(bool shouldLog) const
 {
-    const auto d = data(shouldLog);
+    const auto &s = moments(shouldLog);
     
     LinearModel lm;
     
     try
     {
-        A_CHECK(!d.x.empty() && !d.y.empty(), "Failed to perform linear regression. Empty inputs.");
-        A_CHECK(std::adjacent_find(d.x.begin(), d.x.end(), std::not_equal_to<double>()) != d.x.end(),
-                        "Failed to perform linear regression. Flat mixture.");
+        A_CHECK(s.n, "Failed to perform linear regression. Empty inputs.");
+        A_CHECK(!shouldLog || !_nLog, "Failed to perform linear regression. Negative values can't be logged.");
+        A_CHECK(s.sxx > 0, "Failed to perform linear regression. Flat mixture.");
 
-        const auto m = SS::linearModel(d.y, d.x);
-
-        lm.F     = m.f;
-        lm.p     = m.p;
-        lm.r     = SS::corrPearson(d.x, d.y);
-        lm.c     = m.coeffs[0].est;
-        lm.m     = m.coeffs[1].est;
-        lm.R2    = m.r2;
-        lm.aR2   = m.ar2;
-        lm.SST   = m.total.ss;
-        lm.SSM   = m.model.ss;
-        lm.SSE   = m.error.ss;
-        lm.SST_D = m.total.df;
-        lm.SSM_D = m.model.df;
-        lm.SSE_D = m.error.df;
+        const auto n = s.n;
+        
+        // Degree of freedom for the error
+        const auto eDF = n - 2;
+        
+        lm.m     = s.sxy / s.sxx;
+        lm.c     = s.my - lm.m * s.mx;
+        lm.r     = s.sxy / sqrt(s.sxx * s.syy);
+        lm.SSM   = s.sxy * s.sxy / s.sxx;
+        lm.SSE   = std::max(0.0, s.syy - lm.SSM);
+        lm.SST   = lm.SSM + lm.SSE;
+        lm.SSM_D = 1;
+        lm.SSE_D = eDF;
+        lm.SST_D = n - 1;
+        lm.R2    = lm.SSM / lm.SST;
+        lm.aR2   = eDF ? (1 - (lm.SSE / eDF) / (lm.SST / (n - 1))) : NAN;
+        
+        const auto MSE = eDF ? lm.SSE / eDF : NAN;
+        
+        lm.F = MSE ? lm.SSM / MSE : NAN;
+        lm.p = (!isinf(lm.F) && !isnan(lm.F) && eDF) ? 1.0 - SS::Internal::pf(lm.F, 1, eDF) : NAN;
+        
+        if (!eDF)
+        {
+            lm.SSE = NAN;
+        }
     }
     catch(...)
     {
@@ -70,35 +70,109 @@ namespace Anaquin
         double x, y;
     };
 
-    struct SequinStats : public std::map<SequinID, Point>
+    /*
+     * Measurements for sequins, stored as parallel arrays with an index by sequin ID. Sufficient
+     * statistics for the regression (with and without log-transformation) are updated as the
+     * measurements are added, so fitting a model doesn't need to go through the measurements.
+     */
+    
+    class SequinStats
     {
-        struct Data
-        {
-            std::vector<SequinID> ids;
-            std::vector<double> x, y;
+        public:
+
+            struct Data
+            {
+                std::vector<SequinID> ids;
+                std::vector<double> x, y;
+
+                std::map<SequinID, double> id2x;
+                std::map<SequinID, double> id2y;
+            };
+
+            // Running means and co-moments of the points, updated by Welford's algorithm
+            struct Moments
+            {
+                Counts n = 0;
+                
+                // Means
+                double mx = 0, my = 0;
+                
+                // Sums of squares and cross-products about the means
+                double sxx = 0, syy = 0, sxy = 0;
+                
+                void add(double x, double y);
+                void remove(double x, double y);
+            };
 
-            std::map<SequinID, double> id2x;
-            std::map<SequinID, double> id2y;
-        };
+            // Sequins to their positions in the arrays
+            typedef std::map<SequinID, std::size_t> Index;
+
+            // Iterates the sequins by their IDs, like std::map<SequinID, Point>
+            class const_iterator
+            {
+                public:
+                
+                    const_iterator(const SequinStats *s, Index::const_iterator i) : _s(s), _i(i) {}
+
+                    inline std::pair<const SequinID &, Point> operator*() const
+                    {
+                        return std::pair<const SequinID &, Point>(_i->first, _s->point(_i->second));
+                    }
+                
+                    inline const_iterator &operator++() { ++_i; return *this; }
+                
+                    inline bool operator==(const const_iterator &x) const { return _i == x._i; }
+                    inline bool operator!=(const const_iterator &x) const { return _i != x._i; }
+
+                private:
+                
+                    const SequinStats *_s;
+                    Index::const_iterator _i;
+            };
+
+            void add(const SequinID &, double x, double y);
         
-        inline void add(const SequinID &id, double x, double y)
-        {
-            (*this)[id] = Point(x, y);
-        }
+            // Add to the measurement of a sequin, the expected value must be the same
+            void sum(const SequinID &, double x, double y);
         
-        inline void sum(const SequinID &id, double x, double y)
-        {
-            assert((*this)[id].x == x);            
-            (*this)[id].y += y;
-        }
+            inline Point at(const SequinID &id) const { return point(_index.at(id)); }
+            inline Point operator[](const SequinID &id) const { return at(id); }
+
+            inline std::size_t count(const SequinID &id) const { return _index.count(id); }
+
+            inline std::size_t size() const { return _ids.size(); }
+            inline bool empty() const { return _ids.empty(); }
+
+            inline const_iterator begin() const { return const_iterator(this, _index.begin()); }
+            inline const_iterator end()   const { return const_iterator(this, _index.end());   }
+
+            Limit limitQuant() const;
         
-        Limit limitQuant() const;
+            // Return the x-values and y-values after filtering
+            Data data(bool shouldLog) const;
         
-        // Return the x-values and y-values after filtering
-        Data data(bool shouldLog) const;
+            // Sufficient statistics of the measurements after filtering
+            inline const Moments &moments(bool shouldLog) const { return shouldLog ? _log : _raw; }
+        
+            // Compute a simple linear regression model. By default, this function assumes log-transformation.
+            LinearModel linear(bool shouldLog = true) const;
+
+        private:
+
+            inline Point point(std::size_t i) const { return Point(_x[i], _y[i]); }
+
+            // Update the sufficient statistics for a measurement
+            void update(double x, double y, bool add);
+
+            std::vector<SequinID> _ids;
+            std::vector<double> _x, _y;
+
+            Index _index;
         
-        // Compute a simple linear regression model. By default, this function assumes log-transformation.
-        LinearModel linear(bool shouldLog = true) const;
+            Moments _raw, _log;
+
+            // Points that can't be logged (negative values), not in the moments for the log-transformation
+            Counts _nLog = 0;
     };
 }
 
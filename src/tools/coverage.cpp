@@ -1,5 +1,8 @@
+#include <htslib/sam.h>
+#include <htslib/bgzf.h>
 #include "tools/coverage.hpp"
 #include "VarQuin/VarQuin.hpp"
+#include "writers/writer_sam.hpp"
 
 // Defined in main.cpp
 extern bool __showInfo__;
@@ -80,3 +83,121 @@ void CoverageTool::bedGraph(const ID2Intervals &inters, const CoverageBedGraphOp
 
     o.writer->close();
 }
+
+CoverageTool::Windows::Chrom &CoverageTool::Windows::chrom(const ChrID &cID, Base length)
+{
+    if (!_last || _lastID != cID)
+    {
+        auto &x = _data[cID];
+        
+        if (x.bases.empty())
+        {
+            x.length = length;
+            x.bases.resize((length + _size - 1) / _size, 0);
+        }
+        
+        _last   = &x;
+        _lastID = cID;
+    }
+    
+    return *_last;
+}
+
+void CoverageTool::Windows::add(const ParserSAM::Data &x)
+{
+    if (!x.mapped || !x.isPrimary)
+    {
+        return;
+    }
+
+    const auto b = static_cast<const bam1_t *>(x.b());
+    const auto h = static_cast<const bam_hdr_t *>(x.h());
+
+    auto &c = chrom(x.cID, h->target_len[b->core.tid]);
+
+    const auto cig = bam_get_cigar(b);
+
+    // 0-based position on the reference
+    Base pos = b->core.pos;
+
+    for (uint32_t i = 0; i < b->core.n_cigar; i++)
+    {
+        const auto ol = static_cast<Base>(bam_cigar_oplen(cig[i]));
+
+        switch (bam_cigar_op(cig[i]))
+        {
+            case BAM_CMATCH:
+            case BAM_CEQUAL:
+            case BAM_CDIFF:
+            {
+                const auto end = std::min(pos + ol, c.length);
+
+                // Spread the aligned block [pos, end) over the windows it touches, nothing past the end
+                for (auto w = pos / _size; pos < end && w * _size < end; w++)
+                {
+                    c.bases[w] += std::min(end, (w + 1) * _size) - std::max(pos, w * _size);
+                }
+
+                pos += ol;
+                break;
+            }
+
+            case BAM_CDEL:
+            case BAM_CREF_SKIP:
+            {
+                pos += ol;
+                break;
+            }
+
+            default: { break; }
+        }
+    }
+}
+
+CoverageTool::Windows &CoverageTool::Windows::operator+=(const Windows &x)
+{
+    A_CHECK(_size == x._size, "Windows must have the same size to merge");
+
+    for (const auto &i : x._data)
+    {
+        auto &c = chrom(i.first, i.second.length);
+        
+        A_CHECK(c.length == i.second.length, "Inconsistent length for " + i.first);
+
+        for (std::size_t j = 0; j < c.bases.size(); j++)
+        {
+            c.bases[j] += i.second.bases[j];
+        }
+    }
+
+    return *this;
+}
+
+void CoverageTool::bedGraph(const Windows &x, const FileName &file)
+{
+    // Might be called after subsampling disabled file writing
+    HTSWriting w;
+
+    auto f = bgzf_open(file.c_str(), "w");
+    
+    if (!f)
+    {
+        throw std::runtime_error("Failed to open: " + file);
+    }
+
+    x.each([&](const ChrID &id, Base i, Base j, double depth)
+    {
+        if (depth)
+        {
+            const auto l = (boost::format("%1%\t%2%\t%3%\t%4$.2f\n") % id % i % j % depth).str();
+            
+            if (bgzf_write(f, l.data(), l.size()) < 0)
+            {
+                bgzf_close(f);
+                throw std::runtime_error("Failed to write: " + file);
+            }
+        }
+    });
+
+    bgzf_close(f);
+}
@@ -39,9 +39,107 @@ namespace Anaquin
             std::shared_ptr<Writer> writer;
         };
         
+        /*
+         * Genome-wide sequencing depth in fixed windows, accumulated alignment by alignment in the
+         * same pass as the analysis. Only the aligned bases of primary alignments are counted. Not
+         * thread-safe, each thread should accumulate its own windows and merge them at the end.
+         */
+        
+        class Windows
+        {
+            public:
+
+                Windows(Base size = 1000) : _size(size) {}
+
+                Windows(const Windows &x) : _size(x._size), _data(x._data) {}
+
+                inline Windows &operator=(const Windows &x)
+                {
+                    _last = nullptr;
+                    _size = x._size;
+                    _data = x._data;
+                    
+                    return *this;
+                }
+
+                // Add the aligned bases of an alignment
+                void add(const ParserSAM::Data &);
+
+                // Merge windows accumulated separately (eg: by another thread)
+                Windows &operator+=(const Windows &);
+
+                // Size of a window
+                inline Base size() const { return _size; }
+
+                inline bool empty() const { return _data.empty(); }
+
+                // Number of aligned bases for the chromosome
+                inline Base bases(const ChrID &cID) const
+                {
+                    Base n = 0;
+                    
+                    if (_data.count(cID))
+                    {
+                        for (const auto &i : _data.at(cID).bases)
+                        {
+                            n += i;
+                        }
+                    }
+                    
+                    return n;
+                }
+
+                /*
+                 * Apply the function to every window, (cID, start, end, depth) where the window is
+                 * 0-based and half-open, and the depth is the mean over the window. The last window
+                 * on a chromosome is shortened to the length of the chromosome.
+                 */
+            
+                template <typename F> void each(F f) const
+                {
+                    for (const auto &i : _data)
+                    {
+                        const auto &x = i.second;
+                        
+                        for (std::size_t j = 0; j < x.bases.size(); j++)
+                        {
+                            const auto start = static_cast<Base>(j) * _size;
+                            const auto end   = std::min(start + _size, x.length);
+
+                            f(i.first, start, end, static_cast<double>(x.bases[j]) / (end - start));
+                        }
+                    }
+                }
+
+            private:
+
+                struct Chrom
+                {
+                    // Length of the chromosome
+                    Base length = 0;
+                    
+                    // Number of aligned bases for each window
+                    std::vector<Base> bases;
+                };
+
+                Chrom &chrom(const ChrID &, Base length);
+
+                // Size of a window
+                Base _size;
+
+                std::map<ChrID, Chrom> _data;
+
+                // Most recently accessed chromosome (alignments are usually sorted)
+                Chrom *_last = nullptr;
+                ChrID _lastID;
+        };
+
         static Stats stats(const FileName &, std::map<ChrID, Intervals<>> &);
 
         static void bedGraph(const ID2Intervals &, const CoverageBedGraphOptions &);
+        
+        // Write the windows as bgzip-compressed bedGraph
+        static void bedGraph(const Windows &, const FileName &);
     };
 }
 
@@ -0,0 +1,137 @@
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <exception>
+#include "tools/gtf_data.hpp"
+
+using namespace Anaquin;
+
+GTFData Anaquin::gtfData(const Reader &r, unsigned threads, std::uint64_t minChunk)
+{
+    // Chunks are offsets in the file, that's only possible without compression
+    if (!r.isFile() || r.isCompressed() || threads <= 1)
+    {
+        return gtfData(r);
+    }
+
+    std::ifstream f(r.src(), std::ios::binary | std::ios::ate);
+
+    if (!f.good())
+    {
+        throw InvalidFileError(r.src());
+    }
+
+    const std::uint64_t size = f.tellg();
+
+    // A few chunks for each thread, so that a slow chunk doesn't hold up the others
+    const auto n = std::min<std::uint64_t>(4 * threads, size / std::max<std::uint64_t>(minChunk, 1));
+
+    if (n <= 1)
+    {
+        return gtfData(r);
+    }
+
+    /*
+     * Chunks start after a new line, chunk i is [offs[i], offs[i+1]). A chunk might be empty if a
+     * line is longer than a chunk.
+     */
+
+    std::vector<std::uint64_t> offs(1, 0);
+
+    for (std::uint64_t i = 1; i < n; i++)
+    {
+        auto off = std::max(i * (size / n), offs.back());
+
+        f.clear();
+        f.seekg(off);
+
+        for (char c; off < size && f.get(c) && c != '\n';)
+        {
+            off++;
+        }
+
+        offs.push_back(std::min(off + 1, size));
+    }
+
+    offs.push_back(size);
+
+    std::vector<GTFPart> parts(n);
+    std::vector<std::exception_ptr> errors(n);
+
+    std::atomic<std::uint64_t> next(0);
+
+    auto work = [&]()
+    {
+        std::ifstream f(r.src(), std::ios::binary);
+
+        // Each thread fills its parts from its own arena
+        Arena::Scope scope(std::make_shared<Arena>());
+
+        for (std::uint64_t i; (i = next++) < n;)
+        {
+            try
+            {
+                const auto len = offs[i+1] - offs[i];
+
+                if (!len)
+                {
+                    continue;
+                }
+
+                std::string s(len, '\0');
+
+                f.seekg(offs[i]);
+
+                if (!f.read(&s[0], len))
+                {
+                    throw std::runtime_error("Failed to read: " + r.src());
+                }
+
+                ParserGTF::parse(Reader(s, String), [&](const ParserGTF::Data &x, boost::string_ref, const ParserProgress &)
+                {
+                    addGTF(parts[i], x);
+                });
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> ts;
+
+    for (auto i = 0u; i < std::min<std::uint64_t>(threads, n); i++)
+    {
+        ts.push_back(std::thread(work));
+    }
+
+    for (auto &t : ts)
+    {
+        t.join();
+    }
+
+    // Report the error a serial parse would have seen first
+    for (const auto &i : errors)
+    {
+        if (i)
+        {
+            std::rethrow_exception(i);
+        }
+    }
+
+    Arena::Scope scope(std::make_shared<Arena>());
+
+    GTFData c2d;
+    GTFKeys m_exons;
+
+    // Merging in the order of the file gives the same result as a serial parse
+    for (auto &i : parts)
+    {
+        mergeGTF(c2d, m_exons, i);
+    }
+
+    addIntrons(c2d);
+
+    return c2d;
+}
@@ -1,7 +1,12 @@
 #ifndef GTF_DATA_HPP
 #define GTF_DATA_HPP
 
+#include <cstdint>
+#include <unordered_set>
 #include "data/hist.hpp"
+#include "data/arena.hpp"
+#include "data/intern.hpp"
+#include "data/loci.hpp"
 #include "data/intervals.hpp"
 #include "RnaQuin/RnaQuin.hpp"
 #include "parsers/parser_gtf.hpp"
@@ -33,13 +38,13 @@ namespace Anaquin
         inline bool isBackward() const { return str == Strand::Backward; }
         
         // Eg: chr1
-        ChrID cID;
+        IStr cID;
         
         // Eg: ENSG00000223972.5
-        GeneID gID;
+        IStr gID;
         
         // Eg: ENST00000456328.2
-        TransID tID;
+        IStr tID;
         
         Strand str;
         
@@ -49,13 +54,13 @@ namespace Anaquin
     struct TransData
     {
         // Eg: chr1
-        ChrID cID;
+        IStr cID;
         
         // Eg: ENSG00000223972.5
-        GeneID gID;
+        IStr gID;
         
         // Eg: ENST00000456328.2
-        TransID tID;
+        IStr tID;
         
         Locus l;
     };
@@ -63,36 +68,41 @@ namespace Anaquin
     struct GeneData
     {
         // Eg: chr1
-        ChrID cID;
+        IStr cID;
         
         // Eg: ENSG00000223972.5
-        GeneID gID;
+        IStr gID;
         
         Locus l;
     };
 
     typedef ExonData IntronData;
     
+    /*
+     * Containers are allocated from the arena in scope when the annotation is built (see gtfData()),
+     * there's a node for every transcript and exon.
+     */
+
     struct ChrData
     {
         // Transcripts to Data
-        std::map<TransID, TransData> t2d;
+        ArenaMap<TransID, TransData> t2d;
         
         // Genes to Data
-        std::map<GeneID, GeneData> g2d;
+        ArenaMap<GeneID, GeneData> g2d;
         
         // Transcripts to non-unique exons
-        std::map<TransID, std::set<ExonData>> t2e;
+        ArenaMap<TransID, ArenaSet<ExonData>> t2e;
         
         // Transcripts to unique exons
-        std::map<TransID, std::set<ExonData>> t2ue;
+        ArenaMap<TransID, ArenaSet<ExonData>> t2ue;
 
         // TODO: Forward and reverse?
         // Transcripts to unique introns
-        std::map<TransID, std::set<IntronData>> t2ui;
+        ArenaMap<TransID, ArenaSet<IntronData>> t2ui;
         
         // Transcripts to genes
-        std::map<TransID, GeneID> t2g;
+        ArenaMap<TransID, GeneID> t2g;
         
         // Unique exons (forwards + backwards)
         Counts uexons = 0;
@@ -100,7 +110,7 @@ namespace Anaquin
         // Unique introns (forwards + backwards)
         Counts uintrs = 0;
         
-        std::set<GeneID> gIDs;
+        ArenaSet<GeneID> gIDs;
     };
     
     struct GTFData : public std::map<ChrID, ChrData>
@@ -287,7 +297,7 @@ namespace Anaquin
             MergedIntervals<> r;
 
             // This is needed to merge exons over all transcripts
-            std::map<GeneID, MergedInterval> merged;
+            std::map<GeneID, LocusSet> merged;
             
             // For each transcript...
             for (const auto &i : at(cID).t2ue)
@@ -295,12 +305,6 @@ namespace Anaquin
                 const auto &tID = i.first;
                 const auto &gID = at(cID).t2g.at(tID);
 
-                if (!merged.count(gID))
-                {
-                    // Merging unique exons (doesn't matter how long this is)
-                    merged[gID] = MergedInterval(gID, Locus(1, std::numeric_limits<Base>::max()));
-                }
-                
                 // For each exon in the transcript...
                 for (const auto &j : i.second)
                 {
@@ -310,7 +314,7 @@ namespace Anaquin
                     }
 
                     // Merge all the overlapping exons
-                    merged.at(gID).map(j.l);
+                    merged[gID].add(j.l);
                 }
             }
             
@@ -320,9 +324,8 @@ namespace Anaquin
                 const auto &gID = i.first;
 
                 // For each merged exon in the gene...
-                for (const auto &j : i.second._data)
+                for (const auto &l : i.second.data())
                 {
-                    const auto &l = j.second;
                     r.add(MergedInterval(gID + "-" + toString(l.start) + "-" + toString(l.end), l, gID, gID));
                 }
             }
@@ -372,7 +375,7 @@ namespace Anaquin
         
         inline MergedIntervals<> mergedExons(const ChrID &cID) const
         {
-            MergedIntervals<> r;
+            std::vector<MergedInterval> x;
             
             for (const auto &i : at(cID).t2ue)
             {
@@ -381,12 +384,39 @@ namespace Anaquin
 
                 for (auto &j : i.second)
                 {
-                    r.merge(MergedInterval(i.first + "-" + toString(j.l.start) + "-" + toString(j.l.end),
-                                           j.l,
-                                           gID,
-                                           tID));
+                    x.push_back(MergedInterval(i.first + "-" + toString(j.l.start) + "-" + toString(j.l.end),
+                                               j.l,
+                                               gID,
+                                               tID));
+                }
+            }
+
+            std::sort(x.begin(), x.end(), [&](const MergedInterval &i1, const MergedInterval &i2)
+            {
+                return i1.l().start < i2.l().start || (i1.l().start == i2.l().start && i1.l().end < i2.l().end);
+            });
+
+            std::vector<MergedInterval> merged;
+            
+            // Sorted by position, an exon can only overlap the last merged interval
+            for (const auto &i : x)
+            {
+                if (!merged.empty() && merged.back().l().overlap(i.l()))
+                {
+                    merged.back().merge(i.l());
+                }
+                else
+                {
+                    merged.push_back(i);
                 }
             }
+            
+            MergedIntervals<> r;
+            
+            for (const auto &i : merged)
+            {
+                r.add(i);
+            }
 
             r.build();
             return r;
@@ -471,85 +501,178 @@ namespace Anaquin
         }
     };
 
-    inline GTFData gtfData(const Reader &r)
+    /*
+     * Key for a unique exon or intron, (interned chromosome, strand) and (start, end) packed into
+     * 128 bits. Positions must fit into 32 bits.
+     */
+
+    struct GTFKey
+    {
+        GTFKey(const IStr &cID, Strand str, const Locus &l)
+        {
+            A_CHECK(l.start >= 0 && l.end >= 0 && l.start <= UINT32_MAX && l.end <= UINT32_MAX, "Invalid position: " + l.key());
+
+            hi = (static_cast<std::uint64_t>(cID.id()) << 8) | static_cast<std::uint64_t>(str);
+            lo = (static_cast<std::uint64_t>(l.start) << 32) | static_cast<std::uint64_t>(l.end);
+        }
+
+        inline bool operator==(const GTFKey &x) const { return hi == x.hi && lo == x.lo; }
+
+        struct Hash
+        {
+            inline std::size_t operator()(const GTFKey &x) const
+            {
+                return std::hash<std::uint64_t>()(x.lo ^ (x.hi * 0x9E3779B97F4A7C15ULL));
+            }
+        };
+
+        std::uint64_t hi, lo;
+    };
+
+    typedef std::unordered_set<GTFKey, GTFKey::Hash> GTFKeys;
+
+    /*
+     * Part of an annotation parsed on its own (eg: a chunk of the file). Unique exons depend on
+     * what comes before the part, so they're kept in the order seen and resolved when merging.
+     */
+
+    struct GTFPart
     {
+        // Everything but the unique exons and introns
         GTFData c2d;
-        
-        // Used for unique exons
-        std::map<std::string, Locus> m_exons;
-        
-        // Used for unique introns
-        std::map<std::string, Locus> m_intrs;
 
-        ExonData ed;
-        GeneData gd;
-        TransData td;
-        IntronData id;
-        
-        ParserGTF::parse(r, [&](const ParserGTF::Data &x, const std::string &, const ParserProgress &)
+        // Exons first seen in this part, in the order of the file
+        std::vector<std::pair<GTFKey, ExonData>> uexons;
+
+        // Keys for the exons above
+        GTFKeys keys;
+
+        // Last IDs interned
+        IStrCache cIDs, gIDs, tIDs;
+    };
+
+    inline void addGTF(GTFPart &p, const ParserGTF::Data &x)
+    {
+        switch (x.type)
         {
-            switch (x.type)
+            case Transcript:
             {
-                case Transcript:
-                {
-                    td.l   = x.l;
-                    td.cID = x.cID;
-                    td.gID = x.gID;
-                    td.tID = x.tID;
-
-                    c2d[x.cID].gIDs.insert(td.gID);
-                    c2d[x.cID].t2g[td.tID] = td.gID;
-                    c2d[x.cID].t2d[td.tID] = td;
-                    break;
-                }
+                TransData td;
 
-                case Gene:
-                {
-                    gd.l   = x.l;
-                    gd.cID = x.cID;
-                    gd.gID = x.gID;
-                    
-                    c2d[x.cID].g2d[gd.gID] = gd;
-                    break;
-                }
+                td.l   = x.l;
+                td.cID = p.cIDs(x.cID);
+                td.gID = p.gIDs(x.gID);
+                td.tID = p.tIDs(x.tID);
+
+                p.c2d[x.cID].gIDs.insert(td.gID);
+                p.c2d[x.cID].t2g[td.tID] = td.gID;
+                p.c2d[x.cID].t2d[td.tID] = td;
+                break;
+            }
+
+            case Gene:
+            {
+                GeneData gd;
+
+                gd.l   = x.l;
+                gd.cID = p.cIDs(x.cID);
+                gd.gID = p.gIDs(x.gID);
+
+                p.c2d[x.cID].g2d[gd.gID] = gd;
+                break;
+            }
 
-                case Exon:
+            case Exon:
+            {
+                ExonData ed;
+
+                ed.l   = x.l;
+                ed.str = x.str;
+                ed.cID = p.cIDs(x.cID);
+                ed.gID = p.gIDs(x.gID);
+                ed.tID = p.tIDs(x.tID);
+
+                p.c2d[x.cID].t2e[ed.tID].insert(ed);
+
+                // The key represents a unique exon
+                const GTFKey key(ed.cID, x.str, x.l);
+
+                // Make sure it's unique due to alternative splicing
+                if (p.keys.insert(key).second)
                 {
-                    ed.l   = x.l;
-                    ed.str = x.str;
-                    ed.cID = x.cID;
-                    ed.gID = x.gID;
-                    ed.tID = x.tID;
-
-                    c2d[x.cID].t2e[ed.tID].insert(ed);
-
-                    // The key represents a unique exon
-                    const auto key = (boost::format("%1%_%2%_%3%-%4%") % x.cID
-                                                                       % x.str
-                                                                       % x.l.start
-                                                                       % x.l.end).str();
-
-                    // Make sure it's unique due to alternative splicing
-                    if (!m_exons.count(key))
-                    {
-                        m_exons[key] = x.l;
-                        c2d[x.cID].uexons++;
-                        c2d[x.cID].t2ue[ed.tID].insert(ed);
-                    }
-                    
-                    break;
+                    p.uexons.push_back(std::make_pair(key, ed));
                 }
 
-                // Eg: CDS
-                default: { break; }
+                break;
             }
-        });
-        
-        /*
-         * The information we have is sufficient for exons, transcripts and genes. We just
-         * need to compute introns.
-         */
-        
+
+            // Eg: CDS
+            default: { break; }
+        }
+    }
+
+    /*
+     * Merge a part into the annotation. Parts must be merged in the order of the file, later
+     * transcripts and genes replace earlier ones and earlier exons take precedence.
+     */
+
+    inline void mergeGTF(GTFData &c2d, GTFKeys &m_exons, GTFPart &p)
+    {
+        for (auto &i : p.c2d)
+        {
+            auto j = c2d.find(i.first);
+
+            if (j == c2d.end())
+            {
+                c2d.insert(std::make_pair(i.first, std::move(i.second)));
+                continue;
+            }
+
+            auto &x = j->second;
+            auto &y = i.second;
+
+            for (auto &k : y.t2d) { x.t2d[k.first] = std::move(k.second); }
+            for (auto &k : y.g2d) { x.g2d[k.first] = std::move(k.second); }
+            for (auto &k : y.t2g) { x.t2g[k.first] = std::move(k.second); }
+            for (auto &k : y.t2e) { x.t2e[k.first].insert(k.second.begin(), k.second.end()); }
+
+            x.gIDs.insert(y.gIDs.begin(), y.gIDs.end());
+        }
+
+        // Nothing merged yet, all exons in the part are unique
+        const auto first = m_exons.empty();
+
+        if (first)
+        {
+            m_exons.swap(p.keys);
+        }
+
+        for (const auto &i : p.uexons)
+        {
+            if (first || m_exons.insert(i.first).second)
+            {
+                auto &x = c2d[i.second.cID];
+
+                x.uexons++;
+                x.t2ue[i.second.tID].insert(i.second);
+            }
+        }
+
+        p = GTFPart();
+    }
+
+    /*
+     * The information we have is sufficient for exons, transcripts and genes. We just
+     * need to compute introns.
+     */
+
+    inline void addIntrons(GTFData &c2d)
+    {
+        IntronData id;
+
+        // Used for unique introns
+        GTFKeys m_intrs;
+
         // For each chromosome...
         for (auto &i : c2d)
         {
@@ -603,25 +726,47 @@ namespace Anaquin
 
                     #define MIN_INTRON_LEN 4
                     
-                    const auto key = (boost::format("%1%_%2%-%3%") % x.cID
-                                                                   % id.l.start
-                                                                   % id.l.end).str();
-                    
                     if (isRnaQuin(i.first) || id.l.length() >= MIN_INTRON_LEN)
                     {
-                        if (!m_intrs.count(key))
+                        // Unique within the chromosome regardless of the strand
+                        if (m_intrs.insert(GTFKey(id.cID, Strand::Either, id.l)).second)
                         {
                             c2d[x.cID].uintrs++;
-                            m_intrs[key] = id.l;
                             c2d[x.cID].t2ui[id.tID].insert(id);
                         }
                     }
                 }
             }
         }
+    }
+
+    inline GTFData gtfData(const Reader &r)
+    {
+        // Released when the annotation is
+        Arena::Scope scope(std::make_shared<Arena>());
+
+        GTFPart p;
+
+        ParserGTF::parse(r, [&](const ParserGTF::Data &x, boost::string_ref, const ParserProgress &)
+        {
+            addGTF(p, x);
+        });
+
+        GTFData c2d;
+        GTFKeys m_exons;
+
+        mergeGTF(c2d, m_exons, p);
+        addIntrons(c2d);
 
         return c2d;
     }
+
+    /*
+     * Same as above, but chunks of the file are parsed in parallel. Chunks smaller than minChunk
+     * are not worth a thread. Readers that are not from a file are parsed serially.
+     */
+
+    GTFData gtfData(const Reader &, unsigned threads, std::uint64_t minChunk = 4 * 1024 * 1024);
 }
 
 #endif
@@ -0,0 +1,179 @@
+#include <fstream>
+#include <algorithm>
+#include "tools/gtf_index.hpp"
+
+using namespace Anaquin;
+
+GTFIndex Anaquin::gtfIndex(const Reader &r)
+{
+    std::ifstream f(r.src(), std::ios::binary);
+
+    if (!f.good())
+    {
+        throw InvalidFileError(r.src());
+    }
+
+    GTFIndex x;
+
+    // Range being extended, the last chromosome seen
+    GTFIndex::Range *last = nullptr;
+
+    // Offset of the current line
+    std::uint64_t start = 0;
+
+    // First column of the current line
+    ChrID cID;
+
+    // Still reading the first column?
+    bool first = true;
+
+    // Comment or a line without columns
+    bool skip = false;
+
+    auto endLine = [&](std::uint64_t end)
+    {
+        if (!skip && !cID.empty())
+        {
+            auto &rs = x[cID];
+
+            if (!rs.empty() && &rs.back() == last && last->first + last->second == start)
+            {
+                last->second = end - last->first;
+            }
+            else
+            {
+                rs.push_back(GTFIndex::Range(start, end - start));
+                last = &rs.back();
+            }
+        }
+
+        // Comments and empty lines in the middle of a chromosome don't break up the range
+        else if (last && last->first + last->second == start)
+        {
+            last->second = end - last->first;
+        }
+
+        cID.clear();
+        start = end;
+        first = true;
+        skip  = false;
+    };
+
+    std::vector<char> buf(1 << 20);
+    std::uint64_t off = 0;
+
+    while (f.read(buf.data(), buf.size()) || f.gcount())
+    {
+        const auto n = f.gcount();
+
+        for (std::streamsize i = 0; i < n; i++)
+        {
+            const auto c = buf[i];
+
+            if (c == '\n')
+            {
+                // Lines without a tab have no columns
+                skip = skip || first;
+                endLine(off + i + 1);
+            }
+            else if (first && !skip)
+            {
+                if (c == '\t')
+                {
+                    first = false;
+                }
+                else if (c == '#' && off + i == start)
+                {
+                    skip = true;
+                }
+                else if (c != '\r')
+                {
+                    cID.push_back(c);
+                }
+            }
+        }
+
+        off += n;
+    }
+
+    // The last line might not be terminated
+    if (off != start)
+    {
+        skip = skip || first;
+        endLine(off);
+    }
+
+    for (const auto &i : x)
+    {
+        x.totals[i.first] = gtfTotals(gtfData(r, x, std::set<ChrID> { i.first }), i.first);
+    }
+
+    return x;
+}
+
+GTFTotals Anaquin::gtfTotals(const GTFData &x, const ChrID &cID)
+{
+    GTFTotals t;
+
+    t.genes   = x.nGene(cID);
+    t.trans   = x.countTrans(cID);
+    t.uexons  = x.countUExon(cID);
+    t.uintrs  = x.countUIntr(cID);
+    t.iInters = x.uiInters(cID).stats().n;
+    t.eLen    = x.meInters(cID, Strand::Either).stats().length;
+
+    // Annotations don't always have the genes (eg: only transcripts and exons)
+    t.gLen = x.at(cID).g2d.empty() ? 0 : x.countLen(cID);
+
+    return t;
+}
+
+GTFData Anaquin::gtfData(const Reader &r, const GTFIndex &x, const std::set<ChrID> &cIDs)
+{
+    std::vector<GTFIndex::Range> rs;
+
+    for (const auto &cID : cIDs)
+    {
+        if (x.count(cID))
+        {
+            rs.insert(rs.end(), x.at(cID).begin(), x.at(cID).end());
+        }
+    }
+
+    if (rs.empty())
+    {
+        return GTFData();
+    }
+
+    // Read in the same order as the file
+    std::sort(rs.begin(), rs.end());
+
+    std::ifstream f(r.src(), std::ios::binary);
+
+    if (!f.good())
+    {
+        throw InvalidFileError(r.src());
+    }
+
+    std::string s;
+
+    for (const auto &i : rs)
+    {
+        const auto n = s.size();
+        s.resize(n + i.second);
+
+        f.seekg(i.first);
+
+        if (!f.read(&s[n], i.second))
+        {
+            throw std::runtime_error("Failed to read: " + r.src() + ". The index might be out of date.");
+        }
+
+        if (s.back() != '\n')
+        {
+            s.push_back('\n');
+        }
+    }
+
+    return gtfData(Reader(s, String));
+}
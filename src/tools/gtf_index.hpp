@@ -0,0 +1,58 @@
+#ifndef GTF_INDEX_HPP
+#define GTF_INDEX_HPP
+
+#include <set>
+#include <vector>
+#include <cstdint>
+#include "tools/gtf_data.hpp"
+
+namespace Anaquin
+{
+    /*
+     * Totals for a chromosome in the annotation, enough to count a chromosome in the reference without
+     * loading it (see RnaRef::loadOnly()).
+     */
+
+    struct GTFTotals
+    {
+        Counts genes  = 0;
+        Counts trans  = 0;
+        Counts uexons = 0;
+        Counts uintrs = 0;
+
+        // Intervals for the unique introns (see GTFData::uiInters())
+        Counts iInters = 0;
+
+        // Length of the genes and of the merged exons (see GTFData::meInters())
+        Base gLen = 0;
+        Base eLen = 0;
+    };
+
+    /*
+     * Byte offsets of the chromosomes in a GTF file. Annotations are usually grouped by chromosome,
+     * so a chromosome is a handful of ranges that can be read without parsing the rest of the file.
+     */
+
+    struct GTFIndex : public std::map<ChrID, std::vector<std::pair<std::uint64_t, std::uint64_t>>>
+    {
+        // Eg: [offset, offset + length)
+        typedef std::pair<std::uint64_t, std::uint64_t> Range;
+
+        std::map<ChrID, GTFTotals> totals;
+    };
+
+    // Totals for a chromosome that has been parsed
+    GTFTotals gtfTotals(const GTFData &, const ChrID &);
+
+    /*
+     * Scan the first column of the file for the ranges. Each chromosome is then parsed on its own for
+     * the totals, that's as much work as a full parse, but it's only done once with -cache.
+     */
+
+    GTFIndex gtfIndex(const Reader &);
+
+    // Parse only the chromosomes given, equivalent to parsing everything and dropping the rest
+    GTFData gtfData(const Reader &, const GTFIndex &, const std::set<ChrID> &);
+}
+
+#endif
@@ -0,0 +1,84 @@
+#include <htslib/bgzf.h>
+#include "tools/errors.hpp"
+#include "tools/read_names.hpp"
+
+using namespace Anaquin;
+
+static void writeName(BGZF *f, const ChrID &cID, const ReadID &rID, const FileName &file)
+{
+    const auto l = cID + "\t" + rID + "\n";
+
+    if (bgzf_write(f, l.data(), l.size()) < 0)
+    {
+        throw std::runtime_error("Failed to write: " + file);
+    }
+}
+
+void ReadNames::stream(const FileName &file)
+{
+    auto f = bgzf_open(file.c_str(), "w");
+
+    if (!f)
+    {
+        throw std::runtime_error("Failed to open: " + file);
+    }
+
+    _path = file;
+    _file = std::shared_ptr<BGZF>(f, [](BGZF *f) { bgzf_close(f); });
+}
+
+void ReadNames::sample(Counts n, unsigned seed)
+{
+    A_CHECK(n, "Reservoir must not be empty");
+
+    _max = n;
+    _rand.seed(seed);
+    _sampled.reserve(n);
+}
+
+void ReadNames::add(const ChrID &cID, const ReadID &rID)
+{
+    _n++;
+
+    if (_file)
+    {
+        writeName(_file.get(), cID, rID, _path);
+    }
+
+    if (!_max)
+    {
+        return;
+    }
+    else if (static_cast<Counts>(_sampled.size()) < _max)
+    {
+        _sampled.push_back(Name(cID, rID));
+    }
+    else
+    {
+        // Replace a sampled name with probability max/n (reservoir sampling)
+        const auto i = std::uniform_int_distribution<Counts>(0, _n - 1)(_rand);
+
+        if (i < _max)
+        {
+            _sampled[i] = Name(cID, rID);
+        }
+    }
+}
+
+void ReadNames::close()
+{
+    _file.reset();
+}
+
+void ReadNames::write(const std::vector<Name> &x, const FileName &file)
+{
+    ReadNames r;
+    r.stream(file);
+
+    for (const auto &i : x)
+    {
+        writeName(r._file.get(), i.first, i.second, file);
+    }
+
+    r.close();
+}
@@ -0,0 +1,63 @@
+#ifndef READ_NAMES_HPP
+#define READ_NAMES_HPP
+
+#include <memory>
+#include <random>
+#include <vector>
+#include "data/data.hpp"
+
+struct BGZF;
+
+namespace Anaquin
+{
+    /*
+     * Names of reads (eg: FP alignments) collected without keeping all of them in memory. The names
+     * are either streamed to a BGZF file as they're seen, or sampled by a reservoir of a fixed size.
+     * Nothing is kept by default, only the number of reads.
+     */
+
+    class ReadNames
+    {
+        public:
+
+            typedef std::pair<ChrID, ReadID> Name;
+
+            // Write the names to a BGZF file, one line for each read
+            void stream(const FileName &);
+
+            // Keep a uniform sample of at most n names
+            void sample(Counts n, unsigned seed = 1);
+
+            void add(const ChrID &, const ReadID &);
+
+            // Flush and close the file being streamed
+            void close();
+
+            // Number of reads seen
+            inline Counts count() const { return _n; }
+
+            // Names in the reservoir, in the order they're sampled
+            inline const std::vector<Name> &sampled() const { return _sampled; }
+
+            // Write names in the reservoir to a file (same format as streaming)
+            static void write(const std::vector<Name> &, const FileName &);
+
+        private:
+
+            Counts _n = 0;
+
+            // Size of the reservoir
+            Counts _max = 0;
+
+            std::mt19937 _rand;
+
+            std::vector<Name> _sampled;
+
+            // File being streamed
+            std::shared_ptr<BGZF> _file;
+
+            FileName _path;
+    };
+}
+
+#endif
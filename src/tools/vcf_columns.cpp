@@ -0,0 +1,298 @@
+#include <cstring>
+#include <algorithm>
+#include "tools/vcf_columns.hpp"
+#include <boost/utility/string_ref.hpp>
+
+using namespace Anaquin;
+
+long VCFChrColumns::find(Base x) const
+{
+    auto f = [&](std::uint32_t i, std::uint32_t j) -> long
+    {
+        const auto k = std::lower_bound(starts.begin() + i, starts.begin() + j, x);
+        return k != starts.begin() + j && *k == x ? k - starts.begin() : -1;
+    };
+
+    const auto i = f(0, snps);
+    return i != -1 ? i : f(snps, size());
+}
+
+long VCFChrColumns::find(VarKey x) const
+{
+    const auto i = std::lower_bound(keys.begin(), keys.end(), x);
+    return i != keys.end() && *i == x ? static_cast<long>(rows[i - keys.begin()]) : -1;
+}
+
+Variant VCFChrColumns::variant(const ChrID &cID, std::uint32_t i) const
+{
+    // ID, REF, ALT, QUAL, INFO, FORMAT and the sample
+    Fields toks;
+
+    const auto n = toks.split(boost::string_ref(arena.data() + offs[i], arena.find('\n', offs[i]) - offs[i]), '\t');
+
+    Variant x;
+
+    x.cID = cID;
+    x.id  = toks[0].to_string();
+    x.ref = toks[1].to_string();
+    x.alt = toks[2].to_string();
+    x.l.start = x.l.end = starts[i];
+
+    x.qual = toks[3] != "." ? s2d(toks[3]) : NAN;
+
+    /*
+     * The rest is only decoded here, the same as ParserVCF
+     */
+
+    Fields t;
+
+    if (toks[4] != ".")
+    {
+        Fields infos;
+        infos.split(toks[4], ';');
+
+        for (const auto &info : infos)
+        {
+            t.split(info, '=');
+
+            if (t[0] == "AF") { x.allF = s2f(t[1]); }
+        }
+    }
+
+    if (n > 6)
+    {
+        Fields formats;
+
+        formats.split(toks[5], ':');
+        t.split(toks[6], ':');
+
+        for (auto j = 0u; j < t.size() && j < formats.size(); j++)
+        {
+            if (formats[j] == "AD")
+            {
+                const auto k = t[j].find(',');
+                const auto v = k == boost::string_ref::npos ? t[j] : t[j].substr(k + 1);
+
+                x.readR = s2d(t[j].substr(0, k));
+                x.readV = s2d(v.substr(0, v.find(',')));
+            }
+            else if (formats[j] == "DP")
+            {
+                x.depth = s2d(t[j]);
+            }
+        }
+    }
+
+    return x;
+}
+
+const Variant *VCFColumns::decode(const ChrID &cID, long i) const
+{
+    if (i == -1)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto &x = _vars[cID];
+    auto j = x.find(i);
+
+    if (j == x.end())
+    {
+        j = x.insert(std::make_pair(i, at(cID).variant(cID, i))).first;
+    }
+
+    return &j->second;
+}
+
+const Variant *VCFColumns::findVar(const ChrID &cID, VarKey key) const
+{
+    return count(cID) ? decode(cID, at(cID).find(key)) : nullptr;
+}
+
+const Variant *VCFColumns::findVar(const ChrID &cID, const Locus &l) const
+{
+    return count(cID) ? decode(cID, at(cID).find(l.start)) : nullptr;
+}
+
+std::map<ChrID, std::map<long, Counts>> VCFColumns::hist() const
+{
+    std::map<ChrID, std::map<long, Counts>> r;
+
+    for (const auto &i : *this)
+    {
+        auto &x = r[i.first];
+
+        for (const auto &j : i.second.keys)
+        {
+            x.emplace_hint(x.end(), j, 0);
+        }
+
+        assert(!x.empty());
+    }
+
+    assert(!r.empty());
+    return r;
+}
+
+VCFColumns Anaquin::vcfColumns(const Reader &r)
+{
+    // Row before sorting, seq is the order in the file
+    struct Row
+    {
+        Base start;
+        std::uint64_t off, seq;
+        Mutation type;
+
+        inline bool operator<(const Row &x) const
+        {
+            return start < x.start || (start == x.start && seq < x.seq);
+        }
+    };
+
+    struct Rows
+    {
+        std::vector<Row> snps, inds;
+    };
+
+    VCFColumns c2d;
+    std::map<ChrID, Rows> c2r;
+
+    // Chromosome of the last line, lines are usually sorted by chromosome
+    ChrID lastID;
+    VCFChrColumns *last = nullptr;
+    Rows *lastRows = nullptr;
+
+    boost::string_ref line;
+    std::uint64_t seq = 0;
+
+    // CHROM, POS, ID, REF, ALT, QUAL, FILTER, INFO, FORMAT and the samples
+    Fields toks;
+
+    while (r.nextView(line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        const auto n = toks.split(line, '\t');
+
+        if (n < 8)
+        {
+            throw std::runtime_error("File: " + r.src() + ". Invalid VCF line: " + line.to_string());
+        }
+
+        // Only the first allele, anything that is not really a variant is ignored
+        const auto alt = toks[4].substr(0, toks[4].find(','));
+
+        if (alt == ".")
+        {
+            continue;
+        }
+
+        Base start;
+
+        try
+        {
+            start = static_cast<Base>(s2i(toks[1]));
+        }
+        catch (...)
+        {
+            throw std::runtime_error("File: " + r.src() + ". Invalid position: [" + toks[1].to_string() + "]. Line: " + line.to_string());
+        }
+
+        if (!last || toks[0] != lastID)
+        {
+            lastID   = toks[0].to_string();
+            last     = &c2d[lastID];
+            lastRows = &c2r[lastID];
+        }
+
+        auto &a = last->arena;
+        const auto off = a.size();
+
+        auto add = [&](boost::string_ref x, char c)
+        {
+            a.append(x.data(), x.size());
+            a.push_back(c);
+        };
+
+        add(toks[2], '\t');
+        add(toks[3], '\t');
+        add(alt, '\t');
+        add(toks[5], '\t');
+
+        if (n > 9)
+        {
+            add(toks[7], '\t');
+            add(toks[8], '\t');
+            add(toks[9], '\n');
+        }
+        else
+        {
+            add(toks[7], '\n');
+        }
+
+        const Row x { start, off, seq++, varType(toks[3], alt) };
+        (x.type == SNP ? lastRows->snps : lastRows->inds).push_back(x);
+    }
+
+    for (auto &i : c2r)
+    {
+        auto &x = c2d.at(i.first);
+
+        // Keys of the rows, rows are added in the same order as VCFData::index() so the first wins
+        std::vector<std::pair<VarKey, std::uint32_t>> keys;
+
+        // Sort by position, the last variant wins for a position (same as VCFData)
+        auto add = [&](std::vector<Row> &rows)
+        {
+            if (!std::is_sorted(rows.begin(), rows.end()))
+            {
+                std::sort(rows.begin(), rows.end());
+            }
+
+            for (auto j = 0u; j < rows.size(); j++)
+            {
+                if (j + 1 < rows.size() && rows[j+1].start == rows[j].start)
+                {
+                    continue;
+                }
+
+                const auto p  = x.arena.data() + rows[j].off;
+                const auto id = std::string(p, strchr(p, '\t'));
+
+                keys.push_back(std::make_pair(var2hash(id, rows[j].type, Locus(rows[j].start, rows[j].start)), x.size()));
+
+                x.starts.push_back(rows[j].start);
+                x.offs.push_back(rows[j].off);
+            }
+
+            rows.clear();
+            rows.shrink_to_fit();
+        };
+
+        add(i.second.snps);
+        x.snps = x.size();
+        add(i.second.inds);
+
+        x.starts.shrink_to_fit();
+        x.offs.shrink_to_fit();
+        x.arena.shrink_to_fit();
+
+        std::sort(keys.begin(), keys.end());
+
+        x.keys.reserve(keys.size());
+        x.rows.reserve(keys.size());
+
+        for (const auto &j : keys)
+        {
+            x.keys.push_back(j.first);
+            x.rows.push_back(j.second);
+        }
+    }
+
+    return c2d;
+}
@@ -0,0 +1,129 @@
+#ifndef VCF_COLUMNS_HPP
+#define VCF_COLUMNS_HPP
+
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "tools/vcf_data.hpp"
+
+namespace Anaquin
+{
+    /*
+     * Variants of a chromosome stored by column. Each row is a variant, SNPs come first (sorted by
+     * position) and then indels (sorted by position). The text of a row (ID, alleles, QUAL, INFO,
+     * FORMAT and the first sample) is kept in an arena, and only decoded when a variant is needed.
+     */
+
+    struct VCFChrColumns
+    {
+        // Number of SNPs, rows [0, snps) are SNPs and [snps, size()) are indels
+        std::uint32_t snps = 0;
+
+        // Position of the rows
+        std::vector<Base> starts;
+
+        // Offset of the text of the rows, each text ends with a new line
+        std::vector<std::uint64_t> offs;
+
+        // Eg: "GI_086\tGGAAT\tG\t0\tdist2closest=12\tGT\t1|0\n"
+        std::string arena;
+
+        // Keys of the variants and their rows, sorted by key then row
+        std::vector<VarKey> keys;
+        std::vector<std::uint32_t> rows;
+
+        inline std::uint32_t size() const { return starts.size(); }
+
+        // Row of the variant at the position, SNPs before indels. Returns -1 if there's none.
+        long find(Base) const;
+
+        // Row of the variant with the key, the first row for a collision. Returns -1 if there's none.
+        long find(VarKey) const;
+
+        // Decode the variant of a row
+        Variant variant(const ChrID &, std::uint32_t) const;
+    };
+
+    /*
+     * Compact alternative to VCFData for genome-scale truth VCFs. Variants are decoded (and kept)
+     * when they're found, so the pointers stay valid for as long as the columns. Queries are
+     * thread-safe.
+     */
+
+    struct VCFColumns : public std::map<ChrID, VCFChrColumns>
+    {
+        VCFColumns() {}
+
+        // Decoded variants aren't shared with the copy
+        VCFColumns(const VCFColumns &x) : std::map<ChrID, VCFChrColumns>(x) {}
+        VCFColumns(VCFColumns &&x) : std::map<ChrID, VCFChrColumns>(std::move(x)) {}
+
+        inline VCFColumns &operator=(const VCFColumns &x)
+        {
+            std::map<ChrID, VCFChrColumns>::operator=(x);
+            _vars.clear();
+            return *this;
+        }
+
+        inline VCFColumns &operator=(VCFColumns &&x)
+        {
+            std::map<ChrID, VCFChrColumns>::operator=(std::move(x));
+            _vars.clear();
+            return *this;
+        }
+
+        // Same as VCFData::findVar()
+        const Variant *findVar(const ChrID &, VarKey) const;
+        const Variant *findVar(const ChrID &, const Locus &) const;
+
+        // Same as VCFData::hist()
+        std::map<ChrID, std::map<long, Counts>> hist() const;
+
+        inline Counts countSNP(const ChrID &cID) const
+        {
+            return count(cID) ? at(cID).snps : 0;
+        }
+
+        inline Counts countInd(const ChrID &cID) const
+        {
+            return count(cID) ? at(cID).size() - at(cID).snps : 0;
+        }
+
+        inline Counts countSNP() const
+        {
+            return ::Anaquin::count(*this, [&](const ChrID &cID, const VCFChrColumns &)
+            {
+                return countSNP(cID);
+            });
+        }
+
+        inline Counts countInd() const
+        {
+            return ::Anaquin::count(*this, [&](const ChrID &cID, const VCFChrColumns &)
+            {
+                return countInd(cID);
+            });
+        }
+
+        inline Counts countVar()    const { return countSNP() + countInd(); }
+        inline Counts countSNPSyn() const { return countSNP(); }
+        inline Counts countIndSyn() const { return countInd(); }
+        inline Counts countSNPGen() const { return countSNP() - countSNPSyn(); }
+        inline Counts countIndGen() const { return countInd() - countIndSyn(); }
+
+        private:
+
+            const Variant *decode(const ChrID &, long) const;
+
+            mutable std::mutex _lock;
+
+            // Variants decoded so far, by chromosome and row
+            mutable std::map<ChrID, std::unordered_map<std::uint32_t, Variant>> _vars;
+    };
+
+    // Load a VCF into columns, the variants are the same as vcfData()
+    VCFColumns vcfColumns(const Reader &);
+}
+
+#endif
@@ -0,0 +1,163 @@
+#include <mutex>
+#include <thread>
+#include <exception>
+#include <condition_variable>
+#include "tools/vcf_data.hpp"
+
+using namespace Anaquin;
+
+void Anaquin::vcfStream(const Reader &r, VarFormat format, unsigned threads, VCFFunctor f)
+{
+    if (format != VarFormat::VCF || threads <= 1 || !r.isFile() || !ParserBCF::isBCF(r))
+    {
+        vcfStream(r, format, f);
+        return;
+    }
+
+    // A few regions for each thread, chromosomes are split if there aren't enough
+    auto rs = ParserBCF::regions(r.src());
+
+    if (!rs.empty() && rs.size() < 4 * threads)
+    {
+        rs = ParserBCF::regions(r.src(), (4 * threads + rs.size() - 1) / rs.size());
+    }
+
+    // Not indexed
+    if (rs.size() <= 1)
+    {
+        vcfStream(r, format, f);
+        return;
+    }
+
+    const auto n = rs.size();
+
+    // Threads don't parse further than this many regions past the one being given to the functor
+    const auto ahead = 2 * threads;
+
+    std::vector<std::vector<ParserBCF::Data>> parts(n);
+    std::vector<std::exception_ptr> errors(n);
+    std::vector<bool> done(n);
+
+    std::mutex lock;
+    std::condition_variable cv;
+
+    // Next region to parse and the number of regions given to the functor
+    std::size_t next = 0, used = 0;
+
+    auto work = [&]()
+    {
+        for (;;)
+        {
+            std::size_t i;
+
+            {
+                std::unique_lock<std::mutex> l(lock);
+                cv.wait(l, [&]() { return next >= n || next < used + ahead; });
+
+                if (next >= n)
+                {
+                    return;
+                }
+
+                i = next++;
+            }
+
+            std::vector<ParserBCF::Data> x;
+            std::exception_ptr e;
+
+            try
+            {
+                ParserBCF::parse(r.src(), rs[i], [&](const ParserBCF::Data &d, ParserProgress &)
+                {
+                    x.push_back(d);
+                });
+            }
+            catch (...)
+            {
+                e = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> l(lock);
+                parts[i].swap(x);
+                errors[i] = e;
+                done[i] = true;
+            }
+
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> ts;
+
+    for (auto i = 0u; i < std::min<std::size_t>(threads, n); i++)
+    {
+        ts.push_back(std::thread(work));
+    }
+
+    // Nothing more is parsed, the threads finish the regions they have
+    auto stop = [&]()
+    {
+        {
+            std::lock_guard<std::mutex> l(lock);
+            next = n;
+        }
+
+        cv.notify_all();
+
+        for (auto &t : ts)
+        {
+            t.join();
+        }
+    };
+
+    ParserProgress p;
+
+    try
+    {
+        // The functor sees the variants in the same order as a serial parse
+        for (std::size_t i = 0; i < n; i++)
+        {
+            std::vector<ParserBCF::Data> x;
+
+            {
+                std::unique_lock<std::mutex> l(lock);
+                cv.wait(l, [&]() { return done[i]; });
+
+                // The error a serial parse would have seen first
+                if (errors[i])
+                {
+                    std::rethrow_exception(errors[i]);
+                }
+
+                x.swap(parts[i]);
+                used = i + 1;
+            }
+
+            cv.notify_all();
+
+            for (const auto &j : x)
+            {
+                p.i++;
+                f(j, p);
+
+                if (p.stopped)
+                {
+                    break;
+                }
+            }
+
+            if (p.stopped)
+            {
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        stop();
+        throw;
+    }
+
+    stop();
+}
@@ -1,11 +1,14 @@
 #ifndef VCF_DATA_HPP
 #define VCF_DATA_HPP
 
+#include <functional>
+#include <unordered_map>
 #include "data/hist.hpp"
 #include "data/standard.hpp"
 #include "data/intervals.hpp"
 #include "stats/analyzer.hpp"
 #include "parsers/parser_vcf.hpp"
+#include "parsers/parser_bcf.hpp"
 #include "parsers/parser_varscan.hpp"
 #include "parsers/parser_variants.hpp"
 
@@ -24,6 +27,70 @@ namespace Anaquin
 
     struct VCFData : public std::map<ChrID, VCFChrData>
     {
+        VCFData() {}
+
+        // The index points into the variants, so a copy indexes its own variants
+        VCFData(const VCFData &x) : std::map<ChrID, VCFChrData>(x)
+        {
+            if (x._indexed)
+            {
+                index();
+            }
+        }
+
+        // Moving keeps the nodes, so the index is still valid
+        VCFData(VCFData &&) = default;
+
+        inline VCFData &operator=(const VCFData &x)
+        {
+            std::map<ChrID, VCFChrData>::operator=(x);
+
+            if (x._indexed)
+            {
+                index();
+            }
+            else
+            {
+                unindex();
+            }
+
+            return *this;
+        }
+
+        VCFData &operator=(VCFData &&) = default;
+
+        // Index the variants by their keys for findVar(), done once the variants are loaded
+        inline void index()
+        {
+            _keys.clear();
+
+            for (const auto &i : *this)
+            {
+                auto &x = _keys[i.first];
+                x.reserve(i.second.s2d.size() + i.second.i2d.size());
+
+                // If the keys collide, SNPs come before indels and the first position wins
+                for (const auto &j : i.second.s2d)
+                {
+                    x.insert(std::make_pair(j.second.key(), &j.second));
+                }
+
+                for (const auto &j : i.second.i2d)
+                {
+                    x.insert(std::make_pair(j.second.key(), &j.second));
+                }
+            }
+
+            _indexed = true;
+        }
+
+        // The variants have changed, findVar() can't be used until they're indexed again
+        inline void unindex()
+        {
+            _keys.clear();
+            _indexed = false;
+        }
+
         inline std::map<ChrID, std::map<long, Counts>> hist() const
         {
             std::map<ChrID, std::map<long, Counts>> r;
@@ -49,36 +116,23 @@ namespace Anaquin
             return r;
         }
 
-        inline const Variant * findVar(const ChrID &cID, VarKey key)
+        // Find a variant by its key, the variants must have been indexed
+        inline const Variant * findVar(const ChrID &cID, VarKey key) const
         {
-            if (!count(cID))
+            assert(_indexed);
+
+            const auto i = _keys.find(cID);
+
+            if (i == _keys.end())
             {
                 return nullptr;
             }
-            
-            //for (const auto &i : this->at(cID))
-            {
-                for (const auto &j : this->at(cID).s2d)
-                {
-                    if (key == var2hash(j.second.id, j.second.type(), j.second.l))
-                    {
-                        return &j.second;
-                    }
-                }
-                
-                for (const auto &j : this->at(cID).i2d)
-                {
-                    if (key == var2hash(j.second.id, j.second.type(), j.second.l))
-                    {
-                        return &j.second;
-                    }
-                }
-            }
 
-            return nullptr;
+            const auto j = i->second.find(key);
+            return j != i->second.end() ? j->second : nullptr;
         }
         
-        inline const Variant * findVar(const ChrID &cID, const Locus &l)
+        inline const Variant * findVar(const ChrID &cID, const Locus &l) const
         {
             if (!count(cID))
             {
@@ -162,6 +216,13 @@ namespace Anaquin
         {
             return countSNPSyn() + countIndSyn();
         }
+
+        private:
+
+            bool _indexed = false;
+
+            // Variants by their keys for each chromosome
+            std::map<ChrID, std::unordered_map<VarKey, const Variant *>> _keys;
     };
 
     enum class VarFormat
@@ -175,103 +236,94 @@ namespace Anaquin
     {
         virtual void variantProcessed(const ParserVCF::Data &, const ParserProgress &) = 0;
     };
+
+    // The last variant wins for a position
+    inline void addVar(VCFData &c2d, const Variant &x)
+    {
+        c2d.unindex();
+
+        switch (x.type())
+        {
+            case Mutation::SNP:
+            {
+                c2d[x.cID].s2d[x.l.start] = x;
+                break;
+            }
+
+            case Mutation::Deletion:
+            case Mutation::Insertion:
+            {
+                c2d[x.cID].i2d[x.l.start] = x;
+                break;
+            }
+        }
+    }
     
-    inline VCFData vcfData(const Reader &r, VarFormat format = VarFormat::VCF, VCFDataUser *user = nullptr)
+    typedef std::function<void (const ParserVCF::Data &, ParserProgress &)> VCFFunctor;
+
+    /*
+     * Parse the variants without keeping them, the functor is called for each variant in the file. Parsing
+     * stops once the functor sets ParserProgress::stopped.
+     */
+
+    inline void vcfStream(const Reader &r, VarFormat format, VCFFunctor f)
     {
-        VCFData c2d;
-        
         switch (format)
         {
             case VarFormat::VarScan:
             {
-                ParserVarScan::parse(r, [&](const ParserVarScan::Data &x, const ParserProgress &p)
-                {
-                    switch (x.type())
-                    {
-                        case Mutation::SNP:
-                        {
-                            c2d[x.cID].s2d[x.l.start] = x;
-                            break;
-                        }
-                            
-                        case Mutation::Deletion:
-                        case Mutation::Insertion:
-                        {
-                            c2d[x.cID].i2d[x.l.start] = x;
-                            break;
-                        }
-                    }
-                    
-                    if (user)
-                    {
-                        user->variantProcessed(x, p);
-                    }
-                });
-                
+                ParserVarScan::parse(r, f);
                 break;
             }
                 
             case VarFormat::VCF:
             {
-                ParserVCF::parse(r, [&](const ParserVCF::Data &x, const ParserProgress &p)
+                // Eg: "A.vcf.gz" or "A.bcf"
+                if (r.isFile() && ParserBCF::isBCF(r))
                 {
-                    switch (x.type())
-                    {
-                        case Mutation::SNP:
-                        {
-                            c2d[x.cID].s2d[x.l.start] = x;
-                            break;
-                        }
-                            
-                        case Mutation::Deletion:
-                        case Mutation::Insertion:
-                        {
-                            c2d[x.cID].i2d[x.l.start] = x;
-                            break;
-                        }
-                    }
-                    
-                    if (user)
-                    {
-                        user->variantProcessed(x, p);
-                    }
-                });
+                    ParserBCF::parse(r.src(), f);
+                }
+                else
+                {
+                    ParserVCF::parse(r, f);
+                }
 
                 break;
             }
 
             case VarFormat::Anaquin:
             {
-                ParserVariant::parse(r, [&](const ParserVariant::Data &x, const ParserProgress &p)
-                {
-                    switch (x.type())
-                    {
-                        case Mutation::SNP:
-                        {
-                            c2d[x.cID].s2d[x.l.start] = x;
-                            break;
-                        }
-                            
-                        case Mutation::Deletion:
-                        case Mutation::Insertion:
-                        {
-                            c2d[x.cID].i2d[x.l.start] = x;
-                            break;
-                        }
-                    }
-                    
-                    if (user)
-                    {
-                        user->variantProcessed(x, p);
-                    }
-                });
-                
+                ParserVariant::parse(r, f);
                 break;
             }
         }
+    }
 
+    inline VCFData vcfData(const Reader &r, VarFormat format = VarFormat::VCF, VCFDataUser *user = nullptr)
+    {
+        VCFData c2d;
+        
+        vcfStream(r, format, [&](const ParserVCF::Data &x, const ParserProgress &p)
+        {
+            addVar(c2d, x);
+            
+            if (user)
+            {
+                user->variantProcessed(x, p);
+            }
+        });
+
+        c2d.index();
         return c2d;
     }
+
+    /*
+     * Same as vcfStream(), but an indexed .vcf.gz or .bcf is split into regions parsed by the threads.
+     * Variants are given to the functor in the order of the file, only a few regions are kept in
+     * memory at any time.
+     */
+
+    void vcfStream(const Reader &, VarFormat, unsigned threads, VCFFunctor);
 }
 
 #endif
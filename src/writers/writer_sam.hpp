@@ -14,10 +14,43 @@ extern "C" int __NO_SAM_FILE_WRITING__;
 
 namespace Anaquin
 {
+    /*
+     * WriterSAM::openTerm() disables file writing in htslib. Files written by htslib (eg: BGZF)
+     * enable it in this scope, the previous state is restored at the end.
+     */
+
+    class HTSWriting
+    {
+        public:
+
+            inline HTSWriting() : _old(__NO_SAM_FILE_WRITING__)
+            {
+                __NO_SAM_FILE_WRITING__ = 0;
+            }
+
+            inline ~HTSWriting()
+            {
+                __NO_SAM_FILE_WRITING__ = _old;
+            }
+
+        private:
+
+            const int _old;
+    };
+
     class WriterSAM : public Writer
     {
         public:
 
+            inline ~WriterSAM()
+            {
+                // File writing is disabled only while writing to the terminal
+                if (_term)
+                {
+                    __NO_SAM_FILE_WRITING__ = _noWrite;
+                }
+            }
+
             inline void close() override
             {
                 if (!_term)
@@ -29,6 +62,7 @@ namespace Anaquin
             inline void openTerm()
             {
                 // Disable file writing in the htslib library
+                _noWrite = __NO_SAM_FILE_WRITING__;
                 __NO_SAM_FILE_WRITING__ = 1;
                 
                 _fp = sam_open(System::tmpFile().c_str(), "w");
@@ -101,7 +135,10 @@ namespace Anaquin
 
         private:
 
-            bool _term;
+            bool _term = false;
+
+            // Whether file writing was disabled before openTerm()
+            int _noWrite = 0;
 
             // Whether the header has been written
             bool _header = false;
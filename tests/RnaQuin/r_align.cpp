@@ -1,3 +1,131 @@
+#include <zlib.h>
+#include <fstream>
+#include <catch.hpp>
+#include "test.hpp"
+#include "tools/system.hpp"
+#include "data/standard.hpp"
+#include "tools/gtf_index.hpp"
+#include "RnaQuin/r_align.hpp"
+#include "parsers/parser_sam.hpp"
+#include <boost/algorithm/string/replace.hpp>
+
+using namespace Anaquin;
+
+static const FileName BAM = "tests/data/test2.bam";
+
+// Sequins, then the same genes on a chromosome in the alignments and on one that isn't
+static std::string withGenome()
+{
+    std::ifstream f("tests/data/A1.gtf");
+    const auto seq = std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+
+    auto gtf = seq;
+
+    for (const auto &cID : { "chr1", "chrX_NotAligned" })
+    {
+        auto gen = boost::replace_all_copy(seq, "chrIS", cID);
+        boost::replace_all(gen, " \"R", " \"G");
+        gtf += gen;
+    }
+
+    return gtf;
+}
+
+static RAlign::Stats alignWith(const FileName &gtf, const std::set<ChrID> &only = std::set<ChrID>())
+{
+    Test::clear();
+    Standard::instance().r_rna.loadOnly(only);
+    Standard::instance().addRRef(Reader(gtf));
+    Standard::instance().r_rna.finalize();
+
+    return RAlign::analyze(BAM);
+}
+
+TEST_CASE("RAlign_LoadOnly")
+{
+    const auto file = System::tmpFile() + ".gtf";
+    std::ofstream(file) << withGenome();
+
+    const auto x = alignWith(file);
+    const auto r = std::vector<Counts>
+    {
+        Standard::instance().r_rna.countUExonGen(),
+        Standard::instance().r_rna.countUIntrGen(),
+        Standard::instance().r_rna.nGeneGen(),
+        Standard::instance().r_rna.countTransGen(),
+    };
+
+    // chrX_NotAligned isn't in the header
+    const auto y = alignWith(file, ParserSAM::header(BAM));
+    const auto &s = Standard::instance().r_rna;
+
+    std::remove(file.c_str());
+
+    REQUIRE(x.data.size() == 3);
+    REQUIRE(y.data.size() == 2);
+    REQUIRE(s.skipped().size() == 1);
+    REQUIRE(s.skipped().count("chrX_NotAligned"));
+
+    // Chromosomes not loaded still count towards the reference
+    REQUIRE(s.countUExonGen() == r[0]);
+    REQUIRE(s.countUIntrGen() == r[1]);
+    REQUIRE(s.nGeneGen()      == r[2]);
+    REQUIRE(s.countTransGen() == r[3]);
+
+    REQUIRE(y.gn == x.gn);
+    REQUIRE(y.sn == x.sn);
+    REQUIRE(y.gbm.tp() == x.gbm.tp());
+    REQUIRE(y.gbm.fn() == x.gbm.fn());
+    REQUIRE(y.gem.fn() == x.gem.fn());
+    REQUIRE(y.gim.tp() == x.gim.tp());
+    REQUIRE(y.gim.fn() == x.gim.fn());
+    REQUIRE(y.sbm.fn() == x.sbm.fn());
+    REQUIRE(y.sim.fn() == x.sim.fn());
+}
+
+TEST_CASE("RAlign_Compressed")
+{
+    const auto gtf   = withGenome();
+    const auto plain = System::tmpFile() + ".gtf";
+    const auto gz    = System::tmpFile() + ".gtf.gz";
+
+    std::ofstream(plain) << gtf;
+
+    const auto g = gzopen(gz.c_str(), "wb");
+    gzwrite(g, gtf.data(), static_cast<unsigned>(gtf.size()));
+    gzclose(g);
+
+    const auto x = alignWith(plain);
+    const auto y = alignWith(gz);
+
+    std::remove(plain.c_str());
+    std::remove(gz.c_str());
+
+    // Chromosomes without alignments still count towards the reference
+    REQUIRE(x.data.size() == 3);
+    REQUIRE(x.data.at("chrX_NotAligned").eLvl.nr() == x.data.at("chr1").eLvl.nr());
+
+    REQUIRE(y.data.size() == x.data.size());
+    REQUIRE(y.gn == x.gn);
+    REQUIRE(y.sn == x.sn);
+
+    for (const auto &i : x.data)
+    {
+        const auto &j = y.data.at(i.first);
+
+        REQUIRE(j.eLvl.nr()      == i.second.eLvl.nr());
+        REQUIRE(j.iLvl.m.nr()    == i.second.iLvl.m.nr());
+        REQUIRE(j.aLvl.normal    == i.second.aLvl.normal);
+        REQUIRE(j.aLvl.spliced   == i.second.aLvl.spliced);
+        REQUIRE(j.iLvl.fp.size() == i.second.iLvl.fp.size());
+    }
+
+    REQUIRE(y.gbm.tp() == x.gbm.tp());
+    REQUIRE(y.gbm.fn() == x.gbm.fn());
+    REQUIRE(y.gim.tp() == x.gim.tp());
+    REQUIRE(y.gim.fn() == x.gim.fn());
+}
+
 //#include <catch.hpp>
 //#include "test.hpp"
 //#include "RnaQuin/r_align.hpp"
@@ -0,0 +1,107 @@
+#include <fstream>
+#include <catch.hpp>
+#include "test.hpp"
+#include "tools/system.hpp"
+#include "VarQuin/v_discover.hpp"
+#include "writers/file_writer.hpp"
+#include <boost/algorithm/string.hpp>
+
+using namespace Anaquin;
+
+extern std::string VarDataVCF();
+
+TEST_CASE("VDiscover_Detected")
+{
+    Test::variantA();
+
+    std::vector<std::string> head, body, fps;
+    std::set<std::pair<ChrID, std::string>> snps;
+
+    // Number of FPs added
+    Counts n = 0;
+
+    std::istringstream s(VarDataVCF());
+
+    for (std::string l; std::getline(s, l);)
+    {
+        if (l.empty() || l[0] == '#')
+        {
+            head.push_back(l);
+            continue;
+        }
+
+        std::vector<std::string> t;
+        boost::split(t, l, boost::is_any_of("\t"));
+
+        body.push_back(l);
+
+        // A FP at the same position as the SNP, the alternative allele doesn't match
+        if (t[3].size() == 1 && t[4].size() == 1)
+        {
+            snps.insert(std::make_pair(t[0], t[1]));
+
+            for (const auto &b : { "A", "C", "G", "T" })
+            {
+                if (t[3] != b && t[4] != b)
+                {
+                    t[4] = b;
+                    break;
+                }
+            }
+
+            fps.push_back(boost::algorithm::join(t, "\t"));
+            n++;
+        }
+    }
+
+    // Unsorted, the FPs come before all the TPs
+    body.insert(body.begin(), fps.begin(), fps.end());
+
+    const auto file = System::tmpFile() + ".vcf";
+    std::ofstream o(file);
+
+    for (const auto &i : head) { o << i << "\n"; }
+    for (const auto &i : body) { o << i << "\n"; }
+
+    o.close();
+
+    VDiscover::Options opts;
+    opts.work   = System::tmpFile();
+    opts.format = VarFormat::VCF;
+    opts.writer = std::shared_ptr<Writer>(new FileWriter(opts.work));
+
+    const auto r = VDiscover::analyze(file, opts);
+
+    // Input variants are counted by unique positions
+    REQUIRE(r.n_snp == snps.size());
+
+    std::ifstream f(opts.work + "/VarDiscover_detected.csv");
+    std::vector<std::pair<ChrID, std::string>> rows;
+
+    std::string l;
+    std::getline(f, l);
+
+    while (std::getline(f, l))
+    {
+        std::vector<std::string> t;
+        boost::split(t, l, boost::is_any_of("\t"));
+        rows.push_back(std::make_pair(t[1], t[3]));
+    }
+
+    REQUIRE(rows.size() == body.size());
+
+    // Grouped by chromosomes, TPs before FPs
+    REQUIRE(std::is_sorted(rows.begin(), rows.end(), [&](const std::pair<ChrID, std::string> &x,
+                                                          const std::pair<ChrID, std::string> &y)
+    {
+        return x.first < y.first || (x.first == y.first && x.second == "TP" && y.second == "FP");
+    }));
+
+    REQUIRE(std::count_if(rows.begin(), rows.end(), [&](const std::pair<ChrID, std::string> &x)
+    {
+        return x.second == "FP";
+    }) == n);
+
+    std::remove(file.c_str());
+    System::runCmd("rm -rf " + opts.work);
+}
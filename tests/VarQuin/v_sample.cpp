@@ -1,5 +1,7 @@
+#include <cstdio>
 #include <catch.hpp>
 #include "test.hpp"
+#include "tools/system.hpp"
 #include "VarQuin/v_sample.hpp"
 
 using namespace Anaquin;
@@ -258,3 +260,30 @@ TEST_CASE("VSubsample_Edge")
     REQUIRE(r2.beforeGen == Approx(62.600445186421815));
     REQUIRE(r2.beforeSyn == Approx(1185.0868838763577));
 }
+
+TEST_CASE("VSubsample_Window")
+{
+    __hackBedFile__ = true;
+    
+    Test::clear();
+    
+    Standard::instance().addVStd(Reader(AVA033Bed(), DataMode::String));
+    
+    VSample::Options o;
+    o.meth   = VSample::Method::Reads;
+    o.reads  = 10;
+    o.window = 100;
+    
+    const auto r = VSample::analyze("tests/data/genome.bam", "tests/data/sequins.bam", o);
+    
+    REQUIRE(!r.genWins.empty());
+    REQUIRE(!r.synWins.empty());
+    
+    // Subsampling disables file writing in htslib, the coverage must still be written
+    const auto file = System::tmpFile() + ".bedgraph.gz";
+    
+    CoverageTool::bedGraph(r.synWins, file);
+    
+    REQUIRE(!System::isEmpty(file));
+    std::remove(file.c_str());
+}
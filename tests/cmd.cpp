@@ -11,4 +11,31 @@ TEST_CASE("Anaquin_RnaAlign_HelpShort")
 TEST_CASE("Anaquin_RnaAlign_HelpLong")
 {
     REQUIRE(Test::test("RnaAlign --help").status == 0);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Anaquin_RnaExpression_Window")
+{
+    const auto r = Test::test("RnaExpression -window 100");
+    
+    REQUIRE(r.status == 1);
+    REQUIRE(r.error.find("-window is only supported by RnaAlign and VarSubsample") != std::string::npos);
+}
+
+TEST_CASE("Anaquin_RnaAlign_FPReads")
+{
+    const auto r = Test::test("RnaAlign -fpreads 100");
+    
+    REQUIRE(r.status == 1);
+    REQUIRE(r.error.find("-fpreads is only supported by VarAlign and MetaAlign") != std::string::npos);
+}
+
+TEST_CASE("Anaquin_VarAlign_FPReads")
+{
+    for (const auto &i : { "abc", "0", "-5", "10x" })
+    {
+        const auto r = Test::test("VarAlign -fpreads " + std::string(i));
+        
+        REQUIRE(r.status == 1);
+        REQUIRE(r.error.find(std::string(i) + " not expected for -fpreads") != std::string::npos);
+    }
+}
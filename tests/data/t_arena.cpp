@@ -0,0 +1,120 @@
+#include <catch.hpp>
+#include "data/arena.hpp"
+#include "tools/gtf_data.hpp"
+
+using namespace Anaquin;
+
+TEST_CASE("Arena_Allocate")
+{
+    Arena a(64);
+
+    REQUIRE(a.blocks() == 0);
+
+    auto p1 = static_cast<char *>(a.allocate(10, 1));
+    auto p2 = static_cast<char *>(a.allocate(8, 8));
+
+    // Aligned and within the same block
+    REQUIRE(reinterpret_cast<std::uintptr_t>(p2) % 8 == 0);
+    REQUIRE(p2 >= p1 + 10);
+    REQUIRE(a.blocks() == 1);
+
+    // Larger than a block
+    auto p3 = a.allocate(1000, 16);
+
+    REQUIRE(reinterpret_cast<std::uintptr_t>(p3) % 16 == 0);
+    REQUIRE(a.blocks() == 2);
+    REQUIRE(a.allocs() == 3);
+    REQUIRE(a.bytes()  == 1018);
+}
+
+TEST_CASE("Arena_Scope")
+{
+    REQUIRE(!Arena::current());
+
+    auto a = std::make_shared<Arena>();
+
+    ArenaMap<int, ArenaSet<int>> x;
+
+    {
+        Arena::Scope s1(a);
+
+        REQUIRE(Arena::current() == a);
+
+        {
+            Arena::Scope s2(std::make_shared<Arena>());
+            REQUIRE(Arena::current() != a);
+        }
+
+        REQUIRE(Arena::current() == a);
+
+        ArenaMap<int, ArenaSet<int>> y;
+
+        for (auto i = 0; i < 100; i++)
+        {
+            y[i % 10].insert(i);
+        }
+
+        // A node for each key and value
+        REQUIRE(a->allocs() == 110);
+        REQUIRE(y.get_allocator().arena == a);
+        REQUIRE(y.at(0).get_allocator().arena == a);
+
+        x = std::move(y);
+    }
+
+    REQUIRE(!Arena::current());
+
+    // The map keeps the arena alive
+    a.reset();
+
+    REQUIRE(x.size() == 10);
+    REQUIRE(x.at(9).size() == 10);
+    REQUIRE(*x.at(9).rbegin() == 99);
+
+    // Not in a scope, so it's allocated from the heap
+    x[10].insert(10);
+
+    REQUIRE(!x.at(10).get_allocator().arena);
+}
+
+TEST_CASE("Arena_GTF")
+{
+    const auto x = gtfData(Reader("tests/data/A1.gtf"));
+
+    REQUIRE(!Arena::current());
+    REQUIRE(x.countTrans());
+
+    for (const auto &i : x)
+    {
+        REQUIRE(i.second.t2d.get_allocator().arena);
+        REQUIRE(i.second.t2e.get_allocator().arena == i.second.t2d.get_allocator().arena);
+        REQUIRE(i.second.t2e.begin()->second.get_allocator().arena == i.second.t2d.get_allocator().arena);
+    }
+
+    // Not in a scope, so a copy is allocated from the heap rather than the arena of the original
+    const auto y = x;
+
+    for (const auto &i : y)
+    {
+        REQUIRE(!i.second.t2d.get_allocator().arena);
+        REQUIRE(!i.second.t2e.begin()->second.get_allocator().arena);
+    }
+
+    // Copies in a scope are allocated from its arena
+    const auto a = std::make_shared<Arena>();
+
+    {
+        Arena::Scope scope(a);
+        const auto z = x;
+
+        for (const auto &i : z)
+        {
+            REQUIRE(i.second.t2d.get_allocator().arena == a);
+            REQUIRE(i.second.t2e.begin()->second.get_allocator().arena == a);
+        }
+    }
+
+    REQUIRE(y.countTrans() == x.countTrans());
+    REQUIRE(y.countUExon() == x.countUExon());
+    REQUIRE(y.countUIntr() == x.countUIntr());
+}
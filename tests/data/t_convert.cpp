@@ -38,4 +38,46 @@ TEST_CASE("ss2ld_Test")
     REQUIRE(r6 == "1.000000e-01");
     REQUIRE(r7 == "1.000000e-300");
     REQUIRE(r8 == "1.000000e-01");
-}
\ No newline at end of file
+}
+
+TEST_CASE("s2i_Test")
+{
+    const std::string l = "chrIS\t2345\t-12\t+7 \tA";
+    const boost::string_ref x(l);
+
+    REQUIRE(s2i(x.substr(6, 4)) == 2345);
+    REQUIRE(s2i(x.substr(11, 3)) == -12);
+    REQUIRE(s2i(x.substr(15, 3)) == 7);
+
+    // Parsing stops at the end of the field, not the line
+    REQUIRE(s2i(x.substr(6, 2)) == 23);
+
+    REQUIRE_THROWS(s2i(x.substr(0, 5)));
+    REQUIRE_THROWS(s2i(""));
+    REQUIRE_THROWS(s2i("99999999999999999999"));
+}
+
+TEST_CASE("s2d_Test")
+{
+    const std::string l = "0.25,1e-5,NA,-";
+    const boost::string_ref x(l);
+
+    REQUIRE(s2d(x.substr(0, 4)) == 0.25);
+    REQUIRE(s2d(x.substr(0, 3)) == 0.2);
+    REQUIRE(s2d(x.substr(5, 4)) == Approx(1e-5));
+    REQUIRE(std::isnan(s2d(x.substr(10, 2))));
+    REQUIRE(std::isnan(s2d(x.substr(13, 1))));
+    REQUIRE(s2d(std::string(100, '0') + "1.5") == 1.5);
+
+    REQUIRE_THROWS(s2d("A"));
+    REQUIRE_THROWS(s2d("1e999"));
+
+    // Same rounding as stof()
+    REQUIRE(s2f("113.7408088") == std::stof("113.7408088"));
+    REQUIRE_THROWS(s2f("NA"));
+    REQUIRE_THROWS(s2f("1e99"));
+
+    REQUIRE(s2ld("1e-0300") == Approx(1e-300));
+    REQUIRE_THROWS(s2ld("NA"));
+    REQUIRE(ss2ld("A") == 0);
+}
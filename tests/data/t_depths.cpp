@@ -0,0 +1,166 @@
+#include <catch.hpp>
+#include "data/depths.hpp"
+#include "data/kernels.hpp"
+#include "data/intervals.hpp"
+
+using namespace Anaquin;
+
+TEST_CASE("Depths_Test_1")
+{
+    DepthBlocks d(20000);
+    
+    REQUIRE(d.countBlocks() == 0);
+    
+    d.add(5, 9);
+    d.add(5, 9);
+    d.add(8, 8200);
+    d.add(19990, 30000);
+    
+    std::vector<Base> x, y, z;
+    
+    d.runs([&](Base i, Base j, Base depth)
+    {
+        x.push_back(i);
+        y.push_back(j);
+        z.push_back(depth);
+    });
+    
+    REQUIRE(x == std::vector<Base>({ 0, 5, 8,  10,   8201, 19990 }));
+    REQUIRE(y == std::vector<Base>({ 5, 8, 10, 8201, 19990, 20000 }));
+    REQUIRE(z == std::vector<Base>({ 0, 2, 3,  1,    0,     1 }));
+    
+    // Only the blocks where the alignments start and end
+    REQUIRE(d.countBlocks() == 3);
+}
+
+TEST_CASE("Depths_Test_2")
+{
+    /*
+     * Chromosome-scale interval for the false-positive trackers. Nothing should be allocated
+     * away from the alignments.
+     */
+    
+    Interval i("chr1", Locus(1, std::numeric_limits<Base>::max()));
+    
+    i.map(Locus(1001, 1100));
+    i.map(Locus(1051, 1150));
+    i.map(Locus(5000001, 5000100));
+
+    Base covered = 0;
+    
+    i.bedGraph([&](const ChrID &, Base i, Base j, Base depth)
+    {
+        if (depth)
+        {
+            covered += (j - i);
+        }
+    });
+    
+    REQUIRE(covered == 250);
+    REQUIRE(i.count() == 3);
+}
+
+TEST_CASE("Depths_Test_3")
+{
+    DepthBlocks d1(100);
+    
+    d1.add(10, 20);
+
+    // Copies must be independent
+    auto d2 = d1;
+    d2.add(10, 20);
+    d1.add(50, 60);
+    
+    Base m1 = 0, m2 = 0;
+    
+    d1.runs([&](Base, Base, Base depth) { m1 = std::max(m1, depth); });
+    d2.runs([&](Base, Base, Base depth) { m2 = std::max(m2, depth); });
+    
+    REQUIRE(m1 == 1);
+    REQUIRE(m2 == 2);
+}
+
+TEST_CASE("Depths_Test_4")
+{
+    /*
+     * The AVX2 kernels (if supported) must agree with the scalar kernels, including the tails that
+     * don't fill a whole vector.
+     */
+    
+    auto run = [&](bool avx2)
+    {
+        DepthKernels::use(avx2);
+        
+        DepthBlocks d(20011);
+        
+        for (auto i = 0; i < 3000; i++)
+        {
+            const Base start = (i * 7919) % 20011;
+            d.add(start, start + (i % 150));
+        }
+        
+        std::vector<Base> runs;
+        
+        d.runs([&](Base i, Base, Base depth)
+        {
+            runs.push_back(i);
+            runs.push_back(depth);
+        });
+        
+        DepthHist h;
+        DepthKernels::Summary s;
+        
+        d.hist(h, s);
+        
+        std::vector<Base> x;
+        
+        h.each([&](Base depth, Counts n)
+        {
+            x.push_back(depth);
+            x.push_back(n);
+        });
+        
+        x.push_back(s.zeros);
+        x.push_back(s.sums);
+        x.push_back(s.min);
+        x.push_back(s.max);
+        
+        return std::make_pair(runs, x);
+    };
+    
+    const auto r1 = run(false);
+    const auto r2 = run(true);
+
+    REQUIRE(r1.first  == r2.first);
+    REQUIRE(r1.second == r2.second);
+}
+
+TEST_CASE("Depths_Test_5")
+{
+    // Short intervals don't need a whole block
+    DepthBlocks d(150);
+    
+    d.add(10, 20);
+    d.add(100, 149);
+    
+    REQUIRE(d.countBlocks() == 1);
+    REQUIRE(d.memory() == 150 * sizeof(DepthBlocks::Delta));
+    
+    // The last block is cut to the end of the region
+    DepthBlocks e(DepthBlocks::BlockSize + 10);
+    
+    e.add(DepthBlocks::BlockSize + 1, DepthBlocks::BlockSize + 5);
+    
+    REQUIRE(e.countBlocks() == 1);
+    REQUIRE(e.memory() == 10 * sizeof(DepthBlocks::Delta));
+    
+    std::vector<Base> x;
+    
+    e.runs([&](Base i, Base, Base depth)
+    {
+        x.push_back(i);
+        x.push_back(depth);
+    });
+    
+    REQUIRE(x == std::vector<Base>({ 0, 0, DepthBlocks::BlockSize + 1, 1, DepthBlocks::BlockSize + 6, 0 }));
+}
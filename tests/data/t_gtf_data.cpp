@@ -0,0 +1,69 @@
+#include <fstream>
+#include <catch.hpp>
+#include "tools/gtf_data.hpp"
+
+using namespace Anaquin;
+
+static void requireEqual(const GTFData &x, const GTFData &y)
+{
+    REQUIRE(x.size() == y.size());
+
+    for (const auto &i : x)
+    {
+        const auto &j = y.at(i.first);
+
+        REQUIRE(i.second.t2g    == j.t2g);
+        REQUIRE(i.second.t2e    == j.t2e);
+        REQUIRE(i.second.t2ue   == j.t2ue);
+        REQUIRE(i.second.t2ui   == j.t2ui);
+        REQUIRE(i.second.gIDs   == j.gIDs);
+        REQUIRE(i.second.uexons == j.uexons);
+        REQUIRE(i.second.uintrs == j.uintrs);
+        REQUIRE(i.second.t2d.size() == j.t2d.size());
+        REQUIRE(i.second.g2d.size() == j.g2d.size());
+
+        for (const auto &k : i.second.t2d)
+        {
+            REQUIRE(k.second.l   == j.t2d.at(k.first).l);
+            REQUIRE(k.second.gID == j.t2d.at(k.first).gID);
+        }
+
+        for (const auto &k : i.second.g2d)
+        {
+            REQUIRE(k.second.l == j.g2d.at(k.first).l);
+        }
+
+        // The first transcript seen has the unique exon
+        for (const auto &k : i.second.t2ue)
+        {
+            for (const auto &e : k.second)
+            {
+                REQUIRE(e.tID == j.t2ue.at(k.first).find(e)->tID);
+            }
+        }
+    }
+}
+
+TEST_CASE("GTFData_Parallel")
+{
+    const auto file = "/tmp/GTFData_Parallel.gtf";
+
+    // Duplicated chromosomes, so that exons repeat across chunks
+    std::ofstream o(file);
+    o << std::ifstream("tests/data/A1.gtf").rdbuf() << "\n";
+    o << std::ifstream("tests/data/transcripts.gtf").rdbuf() << "\n";
+    o << std::ifstream("tests/data/A2.gtf").rdbuf();
+    o.close();
+
+    const auto x = gtfData(Reader(file));
+
+    for (auto threads : { 1u, 2u, 3u, 8u })
+    {
+        for (auto chunk : { 1, 100, 10000, 1000000 })
+        {
+            requireEqual(gtfData(Reader(file), threads, chunk), x);
+        }
+    }
+
+    unlink(file);
+}
@@ -0,0 +1,71 @@
+#include <fstream>
+#include <catch.hpp>
+#include "tools/gtf_index.hpp"
+
+using namespace Anaquin;
+
+static void requireEqual(const ChrData &x, const ChrData &y)
+{
+    REQUIRE(x.t2g    == y.t2g);
+    REQUIRE(x.t2e    == y.t2e);
+    REQUIRE(x.t2ue   == y.t2ue);
+    REQUIRE(x.t2ui   == y.t2ui);
+    REQUIRE(x.gIDs   == y.gIDs);
+    REQUIRE(x.uexons == y.uexons);
+    REQUIRE(x.uintrs == y.uintrs);
+}
+
+TEST_CASE("GTFIndex_Partial")
+{
+    std::vector<std::string> A1, T;
+    std::string l;
+
+    for (std::ifstream f("tests/data/A1.gtf"); std::getline(f, l);) { A1.push_back(l); }
+    for (std::ifstream f("tests/data/transcripts.gtf"); std::getline(f, l);) { T.push_back(l); }
+
+    // chrIS is split by chrT, the last line isn't terminated
+    const auto file = "/tmp/GTFIndex_Partial.gtf";
+
+    std::ofstream o(file);
+    o << "# Header\n";
+    for (auto i = 0u; i < A1.size() / 2; i++)  { o << A1[i] << "\n"; }
+    for (const auto &i : T)                    { o << i << "\n"; }
+    for (auto i = A1.size() / 2; i < A1.size(); i++) { o << A1[i] << (i + 1 == A1.size() ? "" : "\n"); }
+    o.close();
+
+    const auto r = Reader(file);
+    const auto x = gtfIndex(r);
+
+    REQUIRE(x.size() == 2);
+    REQUIRE(x.at("chrIS").size() == 2);
+    REQUIRE(x.at("chrT").size()  == 1);
+
+    const auto all = gtfData(r);
+
+    const auto chrIS = gtfData(r, x, std::set<ChrID> { "chrIS" });
+    const auto chrT  = gtfData(r, x, std::set<ChrID> { "chrT", "chr1" });
+    const auto none  = gtfData(r, x, std::set<ChrID> { "chr1" });
+
+    REQUIRE(chrIS.size() == 1);
+    REQUIRE(chrT.size()  == 1);
+    REQUIRE(none.empty());
+
+    requireEqual(chrIS.at("chrIS"), all.at("chrIS"));
+    requireEqual(chrT.at("chrT"), all.at("chrT"));
+
+    // Totals are the same as parsing everything
+    for (const auto &cID : { "chrIS", "chrT" })
+    {
+        const auto &t = x.totals.at(cID);
+
+        REQUIRE(t.genes   == all.nGene(cID));
+        REQUIRE(t.trans   == all.countTrans(cID));
+        REQUIRE(t.uexons  == all.countUExon(cID));
+        REQUIRE(t.uintrs  == all.countUIntr(cID));
+        REQUIRE(t.iInters == all.uiInters(cID).stats().n);
+        REQUIRE(t.gLen    == (all.at(cID).g2d.empty() ? 0 : all.countLen(cID)));
+        REQUIRE(t.eLen    == all.meInters(cID, Strand::Either).stats().length);
+    }
+
+    unlink(file);
+}
@@ -0,0 +1,48 @@
+#include <thread>
+#include <catch.hpp>
+#include "data/intern.hpp"
+
+using namespace Anaquin;
+
+TEST_CASE("Intern_Test_1")
+{
+    const IStr x("chr1");
+    const IStr y(std::string("chr") + "1");
+
+    REQUIRE(x == y);
+    REQUIRE(x.id() == y.id());
+    REQUIRE(x.str() == "chr1");
+    REQUIRE(x == "chr1");
+    REQUIRE(x != IStr("chr2"));
+    REQUIRE(IStr().empty());
+    REQUIRE(IStr("").empty());
+    REQUIRE("ID: " + x == "ID: chr1");
+
+    // Interned from many threads, every string gets a single handle
+    std::vector<std::vector<IStr>> hs(4);
+    std::vector<std::thread> ts;
+
+    for (auto i = 0; i < 4; i++)
+    {
+        ts.push_back(std::thread([&, i]()
+        {
+            for (auto j = 0; j < 100000; j++)
+            {
+                hs[i].push_back(IStr("Intern_" + std::to_string(j)));
+            }
+        }));
+    }
+
+    for (auto &t : ts)
+    {
+        t.join();
+    }
+
+    for (auto j = 0; j < 100000; j++)
+    {
+        REQUIRE(hs[0][j] == hs[3][j]);
+        REQUIRE(hs[1][j].str() == "Intern_" + std::to_string(j));
+    }
+
+    REQUIRE(IStr::size() >= 100003);
+}
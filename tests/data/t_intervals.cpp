@@ -1,4 +1,5 @@
 #include <catch.hpp>
+#include <ss/stats.hpp>
 #include "data/intervals.hpp"
 
 using namespace Anaquin;
@@ -222,4 +223,59 @@ TEST_CASE("Interval_Test_4")
     REQUIRE(!i.overlap(Locus(500,  600)));
     REQUIRE(!i.overlap(Locus(400,  450)));
     REQUIRE(!i.overlap(Locus(1000, 1000)));
+}
+
+TEST_CASE("Interval_Test_6")
+{
+    /*
+     * Percentiles from the depth histogram must agree with sorting every base, including depths
+     * beyond the dense range of the histogram.
+     */
+    
+    Interval i("Test", Locus(0, 9999));
+    
+    for (auto j = 0; j < 2000; j++)
+    {
+        i.add(Locus(100, 5000));
+    }
+    
+    for (auto j = 0; j < 3; j++)
+    {
+        i.add(Locus(4000, 9000));
+    }
+    
+    std::vector<double> x;
+    
+    i.bedGraph([&](const ChrID &, Base i, Base j, Base depth)
+    {
+        for (auto k = i; k < j; k++)
+        {
+            x.push_back(depth);
+        }
+    });
+    
+    std::sort(x.begin(), x.end());
+
+    const auto r = i.stats();
+    
+    REQUIRE(r.length == 10000);
+    REQUIRE(r.hist.size() == 10000);
+    REQUIRE(r.min == 0);
+    REQUIRE(r.max == 2003);
+    REQUIRE(r.p25 == SS::quantile(x, 0.25));
+    REQUIRE(r.p50 == SS::quantile(x, 0.50));
+    REQUIRE(r.p75 == SS::quantile(x, 0.75));
+    
+    DepthHist h;
+
+    REQUIRE(h.empty());
+    REQUIRE(isnan(h.quantile(0.5)));
+
+    h.add(0, 2);
+    h.add(5000, 2);
+    
+    REQUIRE(h.at(1) == 0);
+    REQUIRE(h.at(2) == 5000);
+    REQUIRE(h.reach(5) == -1);
+    REQUIRE(h.quantile(0.5) == 2500);
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include <catch.hpp>
+#include "data/loci.hpp"
+#include "data/minters.hpp"
+
+using namespace Anaquin;
+
+TEST_CASE("Loci_Test_1")
+{
+    LocusSet x;
+
+    REQUIRE(x.empty());
+    REQUIRE(x.length() == 0);
+
+    x.add(Locus(10, 20));
+    x.add(Locus(21, 30));
+    x.add(Locus(15, 18));
+    x.add(Locus(1, 10));
+
+    // Adjacent loci aren't merged
+    REQUIRE(x.size() == 2);
+    REQUIRE(x.data()[0] == Locus(1, 20));
+    REQUIRE(x.data()[1] == Locus(21, 30));
+    REQUIRE(x.length() == 30);
+
+    x.add(Locus(20, 21));
+
+    REQUIRE(x.size() == 1);
+    REQUIRE(x.data()[0] == Locus(1, 30));
+}
+
+TEST_CASE("Loci_Test_2")
+{
+    MergedInterval m("Test", Locus(1, std::numeric_limits<Base>::max()));
+    LocusSet x;
+
+    srand(100);
+
+    // Enough to coalesce several batches
+    for (std::size_t i = 0; i < 5 * LocusSet::BatchSize; i++)
+    {
+        const auto start = 1 + rand() % 1000000;
+        const auto l = Locus(start, start + rand() % 150);
+
+        m.map(l);
+        x.add(l);
+
+        if (!(i % 997))
+        {
+            REQUIRE(x.length() == m.stats().nonZeros);
+        }
+    }
+
+    REQUIRE(x.length() == m.stats().nonZeros);
+    REQUIRE(x.size() == m.size());
+
+    auto i = x.data().begin();
+
+    for (const auto &j : m._data)
+    {
+        REQUIRE(*i++ == j.second);
+    }
+}
@@ -1,4 +1,5 @@
 #include <catch.hpp>
+#include <unordered_map>
 #include "data/locus.hpp"
 
 using namespace Anaquin;
@@ -113,4 +114,19 @@ TEST_CASE("Locus_Overlap")
 
     REQUIRE(s1.overlap(s2) == 6);
     REQUIRE(s2.overlap(s1) == 6);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Locus_Hash")
+{
+    std::unordered_map<Locus, Counts> x;
+
+    x[Locus(10, 20)]++;
+    x[Locus(10, 20)]++;
+    x[Locus(10, 21)]++;
+    x[Locus(20, 10 + 10)]++;
+
+    REQUIRE(x.size() == 3);
+    REQUIRE(x[Locus(10, 20)] == 2);
+    REQUIRE(x[Locus(10, 21)] == 1);
+    REQUIRE(x[Locus(20, 20)] == 1);
+}
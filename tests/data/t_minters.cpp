@@ -311,4 +311,35 @@ TEST_CASE("Merged_5")
     
     REQUIRE(r.length   == 40);
     REQUIRE(r.nonZeros == 20);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Merged_12")
+{
+    MergedIntervals<> x;
+    
+    x.add(MergedInterval("R_3", Locus(301, 400)));
+    x.add(MergedInterval("R_1", Locus(101, 200)));
+    x.add(MergedInterval("R_2", Locus(201, 300)));
+    x.build();
+
+    // Ordinals follow the IDs
+    REQUIRE(x.find("R_1")->ordinal() == 0);
+    REQUIRE(x.find("R_2")->ordinal() == 1);
+    REQUIRE(x.find("R_3")->ordinal() == 2);
+    REQUIRE(x.overlap(Locus(350, 360))->ordinal() == 2);
+
+    OrdinalCounts<Counts> c1(x), c2(x);
+    
+    REQUIRE(c1.size() == 3);
+    
+    c1[*x.find("R_1")]++;
+    c2[*x.find("R_1")]++;
+    c2[*x.find("R_3")] += 5;
+    c1 += c2;
+    
+    REQUIRE(c1[*x.find("R_1")] == 2);
+    REQUIRE(c1[*x.find("R_2")] == 0);
+    REQUIRE(c1[*x.find("R_3")] == 5);
+    
+    REQUIRE_THROWS(c1 += OrdinalCounts<Counts>(2));
+}
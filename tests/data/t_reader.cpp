@@ -0,0 +1,257 @@
+#include <thread>
+#include <cstdio>
+#include <fstream>
+#include <zlib.h>
+#include <unistd.h>
+#include <catch.hpp>
+#include <sys/stat.h>
+#include <htslib/bgzf.h>
+#include "data/reader.hpp"
+
+using namespace Anaquin;
+
+static std::vector<std::string> readLines(const Reader &r)
+{
+    std::string l;
+    std::vector<std::string> x;
+
+    while (r.nextLine(l))
+    {
+        x.push_back(l);
+    }
+
+    return x;
+}
+
+static std::vector<std::string> readViews(const Reader &r)
+{
+    boost::string_ref l;
+    std::vector<std::string> x;
+
+    while (r.nextView(l))
+    {
+        x.push_back(l.to_string());
+    }
+
+    return x;
+}
+
+static std::string readFile(const std::string &file)
+{
+    std::ifstream f(file);
+    return std::string(std::istreambuf_iterator<char>(f.rdbuf()), {});
+}
+
+// Compress with gzip, members are written separately if the text is split
+static void writeGZip(const std::string &file, const std::vector<std::string> &x)
+{
+    std::remove(file.c_str());
+
+    for (const auto &i : x)
+    {
+        auto f = gzopen(file.c_str(), "ab");
+        gzwrite(f, i.data(), i.size());
+        gzclose(f);
+    }
+}
+
+static void writeBGZF(const std::string &file, const std::string &x)
+{
+    auto f = bgzf_open(file.c_str(), "w");
+    bgzf_write(f, x.data(), x.size());
+    bgzf_close(f);
+}
+
+TEST_CASE("Reader_String")
+{
+    const auto x = readLines(Reader(" A\tB \r\n\n \nC\n\nD", DataMode::String));
+
+    // Empty lines are skipped but a line of spaces is not
+    REQUIRE(x.size() == 4);
+    REQUIRE(x[0] == "A\tB");
+    REQUIRE(x[1] == "");
+    REQUIRE(x[2] == "C");
+    REQUIRE(x[3] == "D");
+
+    REQUIRE(readViews(Reader(" A\tB \r\n\n \nC\n\nD", DataMode::String)) == x);
+    REQUIRE(readLines(Reader("A\n", DataMode::String)).size() == 1);
+}
+
+TEST_CASE("Reader_File")
+{
+    const auto file = "tests/data/A1.gtf";
+
+    Reader r(file);
+
+    REQUIRE(r.isFile());
+
+    const auto x = readLines(r);
+
+    // Copies start from the beginning
+    REQUIRE(readViews(Reader(r)) == x);
+
+    // Nothing left, the position is shared with the copy
+    REQUIRE(readLines(r).empty());
+
+    r.reset();
+    REQUIRE(readViews(r) == x);
+
+    std::ifstream f(file);
+    std::string l;
+    std::vector<std::string> y;
+
+    while (std::getline(f, l))
+    {
+        if (!l.empty())
+        {
+            y.push_back(l);
+        }
+    }
+
+    REQUIRE(x == y);
+    REQUIRE(Reader(file).hash() == Reader(std::string(std::istreambuf_iterator<char>(std::ifstream(file).rdbuf()), {}), DataMode::String).hash());
+
+    REQUIRE_THROWS(Reader("tests/data/missing.txt"));
+}
+
+TEST_CASE("Reader_Pipe")
+{
+    const auto fifo = "/tmp/anaquin_t_reader.fifo";
+
+    std::remove(fifo);
+    REQUIRE(!mkfifo(fifo, 0600));
+
+    // Longer than a chunk, lines span the chunks
+    std::string s;
+
+    for (auto i = 0; i < 200000; i++)
+    {
+        s += std::string(i % 50, 'A') + std::to_string(i) + "\n";
+    }
+
+    s += std::string(3 << 20, 'B');
+
+    std::thread t([&]()
+    {
+        std::ofstream o(fifo);
+        o << s;
+    });
+
+    const auto x = readViews(Reader(fifo));
+    t.join();
+    std::remove(fifo);
+
+    REQUIRE(x == readLines(Reader(s, DataMode::String)));
+    REQUIRE(x.size() == 200001);
+    REQUIRE(x.back().size() == (3 << 20));
+}
+
+TEST_CASE("Reader_GZip")
+{
+    const auto file = "tests/data/A1.gtf";
+    const auto gz   = "/tmp/Reader_GZip.gtf.gz";
+
+    const auto s = readFile(file);
+    const auto x = readLines(Reader(file));
+
+    // Two members, the second starts in the middle of a line
+    writeGZip(gz, { s.substr(0, 100000), s.substr(100000) });
+
+    Reader r(gz);
+
+    REQUIRE(r.isCompressed());
+    REQUIRE(!Reader(file).isCompressed());
+    REQUIRE(readViews(r) == x);
+
+    r.reset();
+    REQUIRE(readLines(Reader(r)) == x);
+    REQUIRE(r.hash() == Reader(file).hash());
+}
+
+TEST_CASE("Reader_BGZF")
+{
+    const auto file = "tests/data/A1.gtf";
+    const auto bgz  = "/tmp/Reader_BGZF.gtf.gz";
+
+    // Many blocks, so the threads go around the blocks more than once
+    std::string s;
+
+    for (auto i = 0; i < 20; i++)
+    {
+        s += readFile(file);
+    }
+
+    writeBGZF(bgz, s);
+
+    Reader r(bgz);
+
+    REQUIRE(r.isCompressed());
+
+    const auto x = readLines(Reader(s, DataMode::String));
+
+    REQUIRE(readViews(r) == x);
+    REQUIRE(readLines(r).empty());
+
+    // Back to the start while the threads are still running
+    boost::string_ref l;
+    r.reset();
+    REQUIRE(r.nextView(l));
+    r.reset();
+
+    REQUIRE(readLines(r) == x);
+    REQUIRE(r.hash() == Reader(s, DataMode::String).hash());
+}
+
+TEST_CASE("Reader_GZipPipe")
+{
+    const auto fifo = "/tmp/anaquin_t_reader_gz.fifo";
+    const auto gz   = "/tmp/Reader_GZipPipe.gz";
+
+    const auto s = readFile("tests/data/A1.gtf");
+
+    writeGZip(gz, { s });
+
+    std::remove(fifo);
+    REQUIRE(!mkfifo(fifo, 0600));
+
+    const auto c = readFile(gz);
+
+    std::thread t([&]()
+    {
+        std::ofstream o(fifo);
+        o << c;
+    });
+
+    const auto x = readViews(Reader(fifo));
+    t.join();
+    std::remove(fifo);
+
+    REQUIRE(x == readLines(Reader(s, DataMode::String)));
+}
+
+TEST_CASE("Reader_Compressed_Invalid")
+{
+    const auto s = readFile("tests/data/A1.gtf");
+
+    writeGZip("/tmp/Reader_Invalid.gz", { s });
+    writeBGZF("/tmp/Reader_Invalid.bgz", s);
+
+    for (const auto &file : { std::string("/tmp/Reader_Invalid.gz"), std::string("/tmp/Reader_Invalid.bgz") })
+    {
+        const auto c = readFile(file);
+
+        // Truncated
+        std::ofstream(file) << c.substr(0, c.size() / 2);
+        REQUIRE_THROWS(readLines(Reader(file)));
+
+        // Corrupted in the middle
+        auto d = c;
+        for (auto i = d.size() / 2; i < d.size() / 2 + 100; i++) { d[i] = ~d[i]; }
+        std::ofstream(file) << d;
+        REQUIRE_THROWS(readLines(Reader(file)));
+    }
+
+    // Zstandard isn't supported
+    std::ofstream("/tmp/Reader_Invalid.zst") << std::string("\x28\xb5\x2f\xfd\x00\x00", 6);
+    REQUIRE_THROWS(Reader("/tmp/Reader_Invalid.zst"));
+}
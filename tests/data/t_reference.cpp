@@ -0,0 +1,97 @@
+#include <catch.hpp>
+#include "data/reference.hpp"
+
+using namespace Anaquin;
+
+class TestRef : public Reference<>
+{
+    public:
+
+        inline const MixtureData *mix(const SequinID &id) const { return findMix(Mix_1, id); }
+
+    protected:
+
+        void validate() override
+        {
+            merge(_rawMIDs);
+
+            // Sequins are laid out by their length, eg: S_3 is [3, 6]
+            for (auto &i : _data)
+            {
+                const auto n = findMix(Mix_1, i.first)->length;
+                i.second.l = Locus(n, 2 * n);
+            }
+        }
+};
+
+TEST_CASE("Reference_Test_1")
+{
+    TestRef r;
+
+    for (auto i = 1; i <= 2000; i++)
+    {
+        r.add("S_" + std::to_string(i), i, i * 0.5, Mix_1);
+    }
+
+    // Nothing is validated yet
+    REQUIRE(!r.match("S_10"));
+
+    r.finalize();
+
+    REQUIRE(r.countSeqs() == 2000);
+    REQUIRE(r.match("S_10")->id == "S_10");
+    REQUIRE(r.match("S_10")->l == Locus(10, 20));
+    REQUIRE(!r.match("S_0"));
+
+    REQUIRE(r.mix("S_1999")->abund == Approx(999.5));
+    REQUIRE(!r.mix("S_2001"));
+
+    // S_6 to S_12 overlap, the lowest ID comes first
+    REQUIRE(r.match(Locus(12, 12), Overlap)->id == "S_10");
+
+    // S_6 to S_10 contain [10, 12]
+    REQUIRE(r.match(Locus(10, 12), Contains)->id == "S_10");
+    REQUIRE(r.match(Locus(11, 12), Contains)->id == "S_10");
+    REQUIRE(r.match(Locus(11, 12), Exact) == nullptr);
+    REQUIRE(r.match(Locus(4001, 5000), Overlap) == nullptr);
+
+    // Copies have their own indexes
+    auto x = std::make_shared<TestRef>(r);
+    const auto y = *x;
+    x.reset();
+
+    REQUIRE(y.match("S_10")->id == "S_10");
+    REQUIRE(y.match("S_10") != r.match("S_10"));
+    REQUIRE(y.match(Locus(12, 12), Overlap)->id == "S_10");
+}
+
+TEST_CASE("Reference_Test_2")
+{
+    const auto gtf = "chrIS\tAnaquin\texon\t1\t100\t.\t+\t.\tgene_id \"R1_1\"; transcript_id \"R1_1_1\";\n"
+                     "chrIS\tAnaquin\ttranscript\t1\t100\t.\t+\t.\tgene_id \"R1_1\"; transcript_id \"R1_1_1\";\n"
+                     "chrIS\tAnaquin\texon\t1\t200\t.\t+\t.\tgene_id \"R1_1\"; transcript_id \"R1_1_2\";\n"
+                     "chrIS\tAnaquin\ttranscript\t1\t200\t.\t+\t.\tgene_id \"R1_1\"; transcript_id \"R1_1_2\";\n"
+                     "chrIS\tAnaquin\texon\t301\t400\t.\t+\t.\tgene_id \"R1_2\"; transcript_id \"R1_2_1\";\n"
+                     "chrIS\tAnaquin\ttranscript\t301\t400\t.\t+\t.\tgene_id \"R1_2\"; transcript_id \"R1_2_1\";\n";
+
+    RnaRef r;
+    r.readRef(Reader(gtf, DataMode::String));
+
+    r.add("R1_1_1", 100, 1.0, Mix_1);
+    r.add("R1_1_2", 200, 3.0, Mix_1);
+    r.add("R1_2_1", 100, 8.0, Mix_1);
+    r.add("R1_1_1", 100, 2.0, Mix_2);
+    r.add("R1_1_2", 200, 6.0, Mix_2);
+    r.add("R1_2_1", 100, 2.0, Mix_2);
+
+    r.finalize();
+
+    REQUIRE(r.concent("R1_1", Mix_1) == Approx(4.0));
+    REQUIRE(r.concent("R1_1", Mix_2) == Approx(8.0));
+    REQUIRE(r.concent("R1_2", Mix_2) == Approx(2.0));
+    REQUIRE(r.logFoldGene("R1_1") == Approx(1.0));
+    REQUIRE(r.logFoldGene("R1_2") == Approx(-2.0));
+    REQUIRE(r.logFoldSeq("R1_1_2") == Approx(1.0));
+    REQUIRE_THROWS(r.concent("R1_3", Mix_1));
+    REQUIRE_THROWS(r.logFoldSeq("R1_3_1"));
+}
@@ -0,0 +1,113 @@
+#include <thread>
+#include <fstream>
+#include <catch.hpp>
+#include <sys/stat.h>
+#include "data/snapshot.hpp"
+#include "tools/gtf_data.hpp"
+
+using namespace Anaquin;
+
+TEST_CASE("Snapshot_GTF")
+{
+    Snapshot::dir = "/tmp";
+
+    const auto r = Reader("tests/data/transcripts.gtf");
+    const auto file = Snapshot::path(r.hash(), "test");
+
+    unlink(file.c_str());
+
+    auto parsed = 0;
+
+    auto parse = [&](const Reader &r)
+    {
+        parsed++;
+        return gtfData(r);
+    };
+
+    const auto x = Snapshot::cached<GTFData>(r, "test", parse);
+    const auto y = Snapshot::cached<GTFData>(r, "test", parse);
+
+    // The second one must come from the snapshot
+    REQUIRE(parsed == 1);
+
+    REQUIRE(x.size() == y.size());
+    REQUIRE(x.nGene() == y.nGene());
+    REQUIRE(x.countTrans() == y.countTrans());
+    REQUIRE(x.countUExon() == y.countUExon());
+    REQUIRE(x.countUIntr() == y.countUIntr());
+
+    for (const auto &i : x)
+    {
+        const auto &j = y.at(i.first);
+
+        REQUIRE(i.second.t2g  == j.t2g);
+        REQUIRE(i.second.t2e  == j.t2e);
+        REQUIRE(i.second.t2ue == j.t2ue);
+        REQUIRE(i.second.t2ui == j.t2ui);
+        REQUIRE(i.second.gIDs == j.gIDs);
+
+        for (const auto &k : i.second.t2d)
+        {
+            REQUIRE(k.second.l   == j.t2d.at(k.first).l);
+            REQUIRE(k.second.gID == j.t2d.at(k.first).gID);
+        }
+    }
+
+    GTFData z;
+
+    // A snapshot from another version is ignored (the version follows the magic)
+    {
+        std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+        const std::uint32_t v = Snapshot::Version - 1;
+
+        f.seekp(8);
+        f.write(reinterpret_cast<const char *>(&v), sizeof(v));
+    }
+
+    REQUIRE(!Snapshot::load(r.hash(), "test", z));
+    REQUIRE(z.empty());
+
+    // A corrupted snapshot is ignored
+    truncate(file.c_str(), 100);
+
+    REQUIRE(!Snapshot::load(r.hash(), "test", z));
+    REQUIRE(z.empty());
+
+    Snapshot::dir.clear();
+    unlink(file.c_str());
+}
+
+TEST_CASE("Snapshot_Pipe")
+{
+    Snapshot::dir = "/tmp";
+
+    const auto fifo = "/tmp/anaquin_t_snapshot.fifo";
+
+    std::remove(fifo);
+    REQUIRE(!mkfifo(fifo, 0600));
+
+    std::thread t([&]()
+    {
+        std::ofstream o(fifo);
+        o << std::ifstream("tests/data/transcripts.gtf").rdbuf();
+    });
+
+    const auto r = Reader(fifo);
+
+    // Hashing would read everything, so a pipe is parsed without the cache
+    REQUIRE(!r.canReset());
+    REQUIRE_THROWS(r.hash());
+
+    const auto x = Snapshot::cached<GTFData>(r, "test-pipe", [&](const Reader &r)
+    {
+        return gtfData(r);
+    });
+
+    t.join();
+    std::remove(fifo);
+
+    REQUIRE(x.countTrans() == gtfData(Reader("tests/data/transcripts.gtf")).countTrans());
+    REQUIRE(Reader("tests/data/transcripts.gtf").canReset());
+
+    Snapshot::dir.clear();
+}
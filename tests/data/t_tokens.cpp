@@ -0,0 +1,46 @@
+#include <catch.hpp>
+#include "data/tokens.hpp"
+
+using namespace Anaquin;
+
+TEST_CASE("Fields_Split")
+{
+    Fields x;
+
+    const std::string l1 = "chrIS\t1\t\tA\t";
+
+    REQUIRE(x.split(l1, '\t') == 5);
+    REQUIRE(x[0] == "chrIS");
+    REQUIRE(x[1] == "1");
+    REQUIRE(x[2] == "");
+    REQUIRE(x[3] == "A");
+    REQUIRE(x[4] == "");
+
+    // Same fields as Tokens::split()
+    std::vector<std::string> y;
+    Tokens::split(l1, "\t", y);
+
+    REQUIRE(std::vector<std::string>(x.begin(), x.end()) == y);
+
+    // Fewer fields than the last line
+    REQUIRE(x.split("AF=0.5", '=') == 2);
+    REQUIRE(x[0] == "AF");
+    REQUIRE(x[1] == "0.5");
+
+    REQUIRE(x.split("", ',') == 1);
+    REQUIRE(x[0].empty());
+    REQUIRE(x.end() - x.begin() == 1);
+}
+
+TEST_CASE("Fields_Views")
+{
+    Fields x;
+
+    const std::string l = "A,B";
+
+    x.split(l, ',');
+
+    // Pointing into the line
+    REQUIRE(x[0].data() == l.data());
+    REQUIRE(x[1].data() == l.data() + 2);
+}
@@ -0,0 +1,260 @@
+#include <climits>
+#include <fstream>
+#include <catch.hpp>
+#include <htslib/tbx.h>
+#include <htslib/vcf.h>
+#include "tools/vcf_data.hpp"
+#include "parsers/parser_bcf.hpp"
+
+using namespace Anaquin;
+
+// Write a VCF as bgzipped VCF ("wz") or BCF ("wb") and index it
+static void convert(const FileName &src, const FileName &dst, const char *mode)
+{
+    auto i = hts_open(src.c_str(), "r");
+    auto o = hts_open(dst.c_str(), mode);
+    auto h = bcf_hdr_read(i);
+    auto b = bcf_init();
+
+    bcf_hdr_write(o, h);
+
+    while (bcf_read(i, h, b) >= 0)
+    {
+        bcf_write(o, h, b);
+    }
+
+    bcf_destroy(b);
+    bcf_hdr_destroy(h);
+    hts_close(o);
+    hts_close(i);
+
+    if (!strcmp(mode, "wz"))
+    {
+        REQUIRE(!tbx_index_build(dst.c_str(), 0, &tbx_conf_vcf));
+    }
+    else
+    {
+        REQUIRE(!bcf_index_build(dst.c_str(), 14));
+    }
+}
+
+static std::vector<ParserBCF::Data> parse(const FileName &file)
+{
+    std::vector<ParserBCF::Data> x;
+
+    ParserBCF::parse(file, [&](const ParserBCF::Data &d, const ParserProgress &)
+    {
+        x.push_back(d);
+    });
+
+    return x;
+}
+
+static std::vector<ParserBCF::Data> parse(const FileName &file, const std::vector<ParserBCF::Region> &rs)
+{
+    std::vector<ParserBCF::Data> x;
+
+    for (const auto &r : rs)
+    {
+        ParserBCF::parse(file, r, [&](const ParserBCF::Data &d, const ParserProgress &)
+        {
+            x.push_back(d);
+        });
+    }
+
+    return x;
+}
+
+static bool same(double x, double y)
+{
+    return (std::isnan(x) && std::isnan(y)) || x == y;
+}
+
+static void requireEqual(const std::vector<ParserBCF::Data> &x, const std::vector<ParserBCF::Data> &y)
+{
+    REQUIRE(x.size() == y.size());
+
+    for (auto i = 0u; i < x.size(); i++)
+    {
+        REQUIRE(x[i].cID == y[i].cID);
+        REQUIRE(x[i].id  == y[i].id);
+        REQUIRE(x[i].l   == y[i].l);
+        REQUIRE(x[i].ref == y[i].ref);
+        REQUIRE(x[i].alt == y[i].alt);
+        REQUIRE(same(x[i].allF,  y[i].allF));
+        REQUIRE(same(x[i].readR, y[i].readR));
+        REQUIRE(same(x[i].readV, y[i].readV));
+        REQUIRE(same(x[i].depth, y[i].depth));
+        REQUIRE((same(x[i].qual, y[i].qual) || x[i].qual == Approx(y[i].qual)));
+    }
+}
+
+TEST_CASE("ParserBCF_AVA009")
+{
+    const auto src = "data/VarQuin/AVA009_v001.vcf";
+
+    std::vector<ParserVCF::Data> x;
+
+    ParserVCF::parse(Reader(src), [&](const ParserVCF::Data &d, const ParserProgress &)
+    {
+        x.push_back(d);
+    });
+
+    REQUIRE(x.size() == 245);
+
+    for (const auto &file : { std::string("/tmp/ParserBCF_AVA009.vcf.gz"), std::string("/tmp/ParserBCF_AVA009.bcf") })
+    {
+        convert(src, file, file.back() == 'z' ? "wz" : "wb");
+
+        REQUIRE(ParserBCF::isBCF(Reader(file)));
+
+        const auto y = parse(file);
+        requireEqual(x, y);
+
+        // Only chrIS, split by its length in the header
+        const auto r1 = ParserBCF::regions(file);
+        const auto r3 = ParserBCF::regions(file, 3);
+
+        REQUIRE(r1.size() == 1);
+        REQUIRE(r3.size() == 3);
+        REQUIRE(r3[0].cID == "chrIS");
+        REQUIRE(r3[0].end == r3[1].start);
+        REQUIRE(r3[1].end == r3[2].start);
+
+        requireEqual(y, parse(file, r1));
+        requireEqual(y, parse(file, r3));
+
+        unlink(file.c_str());
+        unlink((file + (file.back() == 'z' ? ".tbi" : ".csi")).c_str());
+    }
+}
+
+TEST_CASE("ParserBCF_Regions")
+{
+    // Chromosomes in the file aren't in the order of the header, the indel spans two regions
+    const auto src = "/tmp/ParserBCF_Regions.vcf";
+
+    std::ofstream o(src);
+    o << "##fileformat=VCFv4.2\n";
+    o << "##contig=<ID=chr1,length=1000>\n";
+    o << "##contig=<ID=chr2,length=1000>\n";
+    o << "##contig=<ID=chr3,length=1000>\n";
+    o << "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\n";
+    o << "chr2\t10\tA\tA\tG\t10\tPASS\t.\n";
+    o << "chr2\t498\tB\tACGTACGT\tA\t20\tPASS\t.\n";
+    o << "chr2\t700\tC\tA\t.\t30\tPASS\t.\n";
+    o << "chr1\t1\tD\tA\tC,T\t.\tPASS\t.\n";
+    o << "chr1\t999\tE\tA\tAT\t40\tPASS\t.\n";
+    o.close();
+
+    for (const auto &file : { std::string("/tmp/ParserBCF_Regions.vcf.gz"), std::string("/tmp/ParserBCF_Regions.bcf") })
+    {
+        convert(src, file, file.back() == 'z' ? "wz" : "wb");
+
+        const auto x = parse(file);
+
+        REQUIRE(x.size() == 4);
+        REQUIRE(x[0].cID == "chr2");
+        REQUIRE(x[2].cID == "chr1");
+        REQUIRE(x[2].alt == "C");
+        REQUIRE(std::isnan(x[2].qual));
+
+        // chr3 has no variants
+        const auto rs = ParserBCF::regions(file, 2);
+
+        REQUIRE(rs.size() == 4);
+        REQUIRE(rs[0].cID == "chr2");
+        REQUIRE(rs[2].cID == "chr1");
+
+        requireEqual(x, parse(file, rs));
+        REQUIRE(parse(file, { ParserBCF::Region { "chr3", 0, INT_MAX } }).empty());
+
+        unlink(file.c_str());
+        unlink((file + (file.back() == 'z' ? ".tbi" : ".csi")).c_str());
+    }
+
+    // Not indexed
+    REQUIRE(ParserBCF::regions(src).empty());
+
+    unlink(src);
+}
+
+TEST_CASE("ParserBCF_Undefined")
+{
+    // INFO and FORMAT not defined in the header are read as text
+    const auto src  = "/tmp/ParserBCF_Undefined.vcf";
+    const auto file = "/tmp/ParserBCF_Undefined.vcf.gz";
+
+    std::ofstream o(src);
+    o << "##fileformat=VCFv4.2\n";
+    o << "##contig=<ID=chr1,length=100000>\n";
+    o << "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tS1\n";
+    o << "chr1\t10\tA\tA\tG\t10\tPASS\tDP=30;AF=0.25\tGT:AD:DP\t0/1:20,10:30\n";
+    o << "chr1\t20\tB\tA\tT\t10\tPASS\t.\tGT:AD\t0/1:7\n";
+    o.close();
+
+    convert(src, file, "wz");
+
+    const auto x = parse(file);
+
+    REQUIRE(x.size() == 2);
+    REQUIRE(x[0].allF  == Approx(0.25));
+    REQUIRE(x[0].readR == 20);
+    REQUIRE(x[0].readV == 10);
+    REQUIRE(x[0].depth == 30);
+    REQUIRE(std::isnan(x[1].allF));
+    REQUIRE(x[1].readR == 7);
+    REQUIRE(x[1].readV == 7);
+
+    unlink(src);
+    unlink(file);
+    unlink((std::string(file) + ".tbi").c_str());
+}
+
+TEST_CASE("ParserBCF_Threads")
+{
+    const auto src  = "data/VarQuin/AVA009_v001.vcf";
+    const auto file = "/tmp/ParserBCF_Threads.vcf.gz";
+
+    convert(src, file, "wz");
+
+    std::vector<VarKey> x, y;
+
+    vcfStream(Reader(src), VarFormat::VCF, [&](const ParserVCF::Data &d, const ParserProgress &)
+    {
+        x.push_back(d.key());
+    });
+
+    // More regions than threads, so the threads wait for the regions to be used
+    vcfStream(Reader(file), VarFormat::VCF, 2, [&](const ParserVCF::Data &d, const ParserProgress &p)
+    {
+        REQUIRE(p.i == static_cast<long long>(y.size()) + 1);
+        y.push_back(d.key());
+    });
+
+    // Same variants in the same order as parsing the text
+    REQUIRE(x.size() == 245);
+    REQUIRE(x == y);
+
+    // Errors from the functor stop the threads
+    REQUIRE_THROWS(vcfStream(Reader(file), VarFormat::VCF, 2, [&](const ParserVCF::Data &, const ParserProgress &p)
+    {
+        if (p.i == 100) { throw std::runtime_error("Stop"); }
+    }));
+
+    // The functor can stop the parsing, same as a serial parse
+    for (auto threads : { 1u, 2u })
+    {
+        Counts n = 0;
+
+        vcfStream(Reader(file), VarFormat::VCF, threads, [&](const ParserVCF::Data &, ParserProgress &p)
+        {
+            if (++n == 100) { p.stopped = true; }
+        });
+
+        REQUIRE(n == 100);
+    }
+
+    unlink(file);
+    unlink((std::string(file) + ".tbi").c_str());
+}
@@ -1,4 +1,5 @@
 #include <catch.hpp>
+#include "parsers/parser_gtf.hpp"
 #include "parsers/parser_gtf2.hpp"
 
 using namespace Anaquin;
@@ -40,13 +41,28 @@ TEST_CASE("ParserGTF_1")
     REQUIRE(t2d["R1_63_1"].fpkm == 1783.9793649586);
 }
 
+TEST_CASE("ParserGTF_Attrs")
+{
+    std::map<std::string, std::string> x;
+
+    ParserGTF::attrs("gene_id \"R_5_3\"; transcript_id \"R_5_3_R\";  FPKM 2.5;gene_name \"A B\"; ; level", [&](boost::string_ref name, boost::string_ref val)
+    {
+        x[name.to_string()] = val.to_string();
+    });
+
+    REQUIRE(x.size() == 3);
+    REQUIRE(x["gene_id"] == "R_5_3");
+    REQUIRE(x["transcript_id"] == "R_5_3_R");
+    REQUIRE(x["FPKM"] == "2.5");
+}
+
 #ifdef INTERNAL_TESTING
 
 TEST_CASE("ParserGTF_Gencode")
 {
     std::vector<Feature> fs;
     
-    ParserGTF::parse(Reader("tests/data/GeneCodeV23Annotation.gtf"), [&](const ParserGTF::Data &f, const std::string &, const ParserProgress &)
+    ParserGTF::parse(Reader("tests/data/GeneCodeV23Annotation.gtf"), [&](const ParserGTF::Data &f, boost::string_ref, const ParserProgress &)
     {
         fs.push_back(f);
     });
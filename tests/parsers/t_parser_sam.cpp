@@ -1,4 +1,7 @@
+#include <cstdio>
+#include <fstream>
 #include <catch.hpp>
+#include "tools/system.hpp"
 #include "parsers/parser_sam.hpp"
 
 using namespace Anaquin;
@@ -100,6 +103,33 @@ TEST_CASE("Test_SoftClip")
     REQUIRE(r1[1].l.end   == 4106465);
 }
 
+TEST_CASE("Test_Chrom")
+{
+    const auto file = System::tmpFile() + ".sam";
+
+    // Chromosomes alternate, the name must follow them even though it's only copied when it changes
+    std::ofstream o(file);
+    o << "@SQ\tSN:chr1\tLN:1000\n@SQ\tSN:chr2\tLN:1000\n";
+    o << "R1\t0\tchr1\t10\t60\t10M\t*\t0\t0\tAAAAAAAAAA\t*\n";
+    o << "R2\t0\tchr1\t20\t60\t10M\t*\t0\t0\tAAAAAAAAAA\t*\n";
+    o << "R3\t0\tchr2\t10\t60\t10M\t*\t0\t0\tAAAAAAAAAA\t*\n";
+    o << "R4\t4\t*\t0\t0\t*\t*\t0\t0\tAAAAAAAAAA\t*\n";
+    o << "R5\t0\tchr2\t30\t60\t10M\t*\t0\t0\tAAAAAAAAAA\t*\n";
+    o << "R6\t0\tchr1\t30\t60\t10M\t*\t0\t0\tAAAAAAAAAA\t*\n";
+    o.close();
+
+    std::vector<ChrID> x;
+
+    ParserSAM::parse(file, [&](ParserSAM::Data &d, const ParserSAM::Info &)
+    {
+        REQUIRE(d.cID == (d.iCID().empty() ? "*" : d.iCID().str()));
+        x.push_back(d.cID);
+    });
+
+    std::remove(file.c_str());
+    REQUIRE(x == std::vector<ChrID>({ "chr1", "chr1", "chr2", "*", "chr2", "chr1" }));
+}
+
 //TEST_CASE("Test_Junction")
 //{
 //    std::vector<Alignment> aligns;
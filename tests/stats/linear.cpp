@@ -0,0 +1,123 @@
+#include <catch.hpp>
+#include "stats/linear.hpp"
+#include <ss/regression/linear.hpp>
+
+using namespace Anaquin;
+
+static void requireModel(const SequinStats &s, bool shouldLog)
+{
+    const auto d  = s.data(shouldLog);
+    const auto lm = s.linear(shouldLog);
+    const auto m  = SS::linearModel(d.y, d.x);
+
+    REQUIRE(lm.c   == Approx(m.coeffs[0].est));
+    REQUIRE(lm.m   == Approx(m.coeffs[1].est));
+    REQUIRE(lm.r   == Approx(SS::corrPearson(d.x, d.y)));
+    REQUIRE(lm.R2  == Approx(m.r2));
+    REQUIRE(lm.aR2 == Approx(m.ar2));
+    REQUIRE(lm.F   == Approx(m.f));
+    REQUIRE(lm.p   == Approx(m.p).epsilon(1e-6));
+    REQUIRE(lm.SST == Approx(m.total.ss));
+    REQUIRE(lm.SSM == Approx(m.model.ss));
+    REQUIRE(lm.SSE == Approx(m.error.ss));
+    REQUIRE(lm.SST_D == m.total.df);
+    REQUIRE(lm.SSM_D == m.model.df);
+    REQUIRE(lm.SSE_D == m.error.df);
+}
+
+TEST_CASE("SequinStats_Linear_1")
+{
+    SequinStats s;
+
+    srand(100);
+
+    for (auto i = 0; i < 500; i++)
+    {
+        const auto x = pow(2, 1 + rand() % 15);
+        s.add("S_" + std::to_string(i), x, x * (0.5 + (rand() % 1000) / 1000.0));
+    }
+
+    // Not used for regression
+    s.add("S_NAN", NAN, 10);
+
+    REQUIRE(s.size() == 501);
+    REQUIRE(s.moments(true).n == 500);
+
+    requireModel(s, true);
+    requireModel(s, false);
+
+    // Replacing and summing must update the statistics
+    s.add("S_10", 4, 2);
+    s.sum("S_10", 4, 3);
+    s.sum("S_20", s.at("S_20").x, 100);
+
+    REQUIRE(s.size() == 501);
+    REQUIRE(s["S_10"].y == 5);
+
+    requireModel(s, true);
+    requireModel(s, false);
+}
+
+TEST_CASE("SequinStats_Linear_2")
+{
+    SequinStats s;
+
+    s.add("S_2", 2, 3);
+    s.add("S_1", 1, 1);
+
+    // Iterated by the sequin IDs
+    REQUIRE((*s.begin()).first == "S_1");
+    REQUIRE(s.data(false).ids.front() == "S_1");
+    REQUIRE(s.limitQuant().id == "S_1");
+
+    // No degree of freedom for the error
+    const auto lm = s.linear(false);
+
+    REQUIRE(lm.m == Approx(2.0));
+    REQUIRE(lm.c == Approx(-1.0));
+    REQUIRE(lm.R2 == Approx(1.0));
+    REQUIRE(isnan(lm.SSE));
+    REQUIRE(isnan(lm.p));
+
+    // Flat mixture
+    s.add("S_2", 1, 3);
+    REQUIRE(isnan(s.linear(false).m));
+}
+
+TEST_CASE("SequinStats_Linear_3")
+{
+    SequinStats s;
+
+    s.add("S_1", 1, 2);
+    s.add("S_2", 2, 3);
+    s.add("S_3", 4, 9);
+    s.add("S_4", 8, 15);
+
+    // Zero is logged as zero, the point is kept
+    s.add("S_5", 16, 0);
+
+    REQUIRE(s.moments(true).n == 5);
+    REQUIRE(s.data(true).x.size() == 5);
+    REQUIRE(s.data(true).id2y.at("S_5") == 0);
+
+    requireModel(s, true);
+    requireModel(s, false);
+
+    // Negative values can't be logged, no model for the log-transformation
+    s.add("S_6", -1, 4);
+
+    REQUIRE(s.moments(false).n == 6);
+    REQUIRE(s.data(true).x.size() == 6);
+    REQUIRE(isnan(s.linear(true).m));
+    REQUIRE(isnan(SS::linearModel(s.data(true).y, s.data(true).x).coeffs[1].est));
+
+    requireModel(s, false);
+
+    // Replacing the negative value gives back the model
+    s.add("S_6", 32, 60);
+
+    REQUIRE(s.moments(true).n == 6);
+    REQUIRE(!isnan(s.linear(true).m));
+
+    requireModel(s, true);
+}
@@ -0,0 +1,114 @@
+#include <fstream>
+#include <catch.hpp>
+#include <htslib/bgzf.h>
+#include "tools/coverage.hpp"
+
+using namespace Anaquin;
+
+TEST_CASE("Coverage_Windows_1")
+{
+    CoverageTool::Windows w(10);
+
+    REQUIRE(w.empty());
+
+    ParserSAM::parse("tests/data/insert.sam", [&](ParserSAM::Data &x, const ParserSAM::Info &)
+    {
+        w.add(x);
+    });
+
+    /*
+     * 8288747	60	23M2I58M42S
+     *
+     * Aligned to [8288746, 8288827) (0-based), the insertion and clipping aren't counted.
+     */
+
+    REQUIRE(!w.empty());
+    REQUIRE(w.bases("chrT") == 81);
+
+    std::map<Base, double> r;
+
+    w.each([&](const ChrID &, Base i, Base j, double depth)
+    {
+        if (depth)
+        {
+            REQUIRE(j - i == 10);
+            r[i] = depth;
+        }
+    });
+
+    REQUIRE(r.size() == 9);
+    REQUIRE(r.begin()->first  == 8288740);
+    REQUIRE(r.begin()->second == Approx(0.4));
+    REQUIRE(r.rbegin()->first  == 8288820);
+    REQUIRE(r.rbegin()->second == Approx(0.7));
+
+    for (const auto &i : r)
+    {
+        if (i.first != 8288740 && i.first != 8288820)
+        {
+            REQUIRE(i.second == Approx(1.0));
+        }
+    }
+
+    // Merging windows accumulated separately is the same as accumulating them together
+    auto m = w;
+    m += w;
+
+    REQUIRE(m.bases("chrT") == 162);
+    REQUIRE(w.bases("chrT") == 81);
+
+    REQUIRE_THROWS(m += CoverageTool::Windows(100));
+}
+
+TEST_CASE("Coverage_Windows_2")
+{
+    CoverageTool::Windows w(100);
+
+    ParserSAM::parse("tests/data/insert.sam", [&](ParserSAM::Data &x, const ParserSAM::Info &)
+    {
+        w.add(x);
+    });
+
+    const auto file = "/tmp/Coverage_Windows_2.bedgraph.gz";
+    CoverageTool::bedGraph(w, file);
+
+    auto f = bgzf_open(file, "r");
+    REQUIRE(f);
+
+    char buf[1024];
+    const auto n = bgzf_read(f, buf, sizeof(buf));
+    bgzf_close(f);
+
+    REQUIRE(std::string(buf, n) == "chrT\t8288700\t8288800\t0.54\nchrT\t8288800\t8288900\t0.27\n");
+}
+
+TEST_CASE("Coverage_Windows_3")
+{
+    // The read runs past the end of the chromosome, only [8288746, 8288765) is counted
+    const auto file = "/tmp/Coverage_Windows_3.sam";
+
+    std::ofstream o(file);
+    o << "@SQ\tSN:chrT\tLN:8288765\n";
+    o << "R\t0\tchrT\t8288747\t60\t23M2I58M42S\t*\t0\t0\t*\t*\n";
+    o.close();
+
+    CoverageTool::Windows w(10);
+
+    ParserSAM::parse(file, [&](ParserSAM::Data &x, const ParserSAM::Info &)
+    {
+        w.add(x);
+    });
+
+    REQUIRE(w.bases("chrT") == 19);
+
+    double min = 0;
+
+    w.each([&](const ChrID &, Base, Base, double depth)
+    {
+        min = std::min(min, depth);
+    });
+
+    REQUIRE(min == 0);
+
+    unlink(file);
+}
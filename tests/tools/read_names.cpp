@@ -0,0 +1,58 @@
+#include <catch.hpp>
+#include <htslib/bgzf.h>
+#include "tools/read_names.hpp"
+
+using namespace Anaquin;
+
+TEST_CASE("ReadNames_Sample")
+{
+    ReadNames r;
+    r.sample(100);
+
+    for (auto i = 0; i < 100000; i++)
+    {
+        r.add("chrT", "R_" + std::to_string(i));
+    }
+
+    REQUIRE(r.count() == 100000);
+    REQUIRE(r.sampled().size() == 100);
+
+    // The reservoir should be spread over the reads, not just the first ones
+    auto late = 0;
+
+    for (const auto &i : r.sampled())
+    {
+        REQUIRE(i.first == "chrT");
+
+        if (std::stoi(i.second.substr(2)) >= 50000)
+        {
+            late++;
+        }
+    }
+
+    REQUIRE(late > 25);
+    REQUIRE(late < 75);
+}
+
+TEST_CASE("ReadNames_Stream")
+{
+    const auto file = "/tmp/ReadNames_Stream.txt.gz";
+
+    ReadNames r;
+    r.stream(file);
+    r.add("chrT", "R_1");
+    r.add("chr1", "R_2");
+    r.close();
+
+    REQUIRE(r.count() == 2);
+    REQUIRE(r.sampled().empty());
+
+    auto f = bgzf_open(file, "r");
+    REQUIRE(f);
+
+    char buf[1024];
+    const auto n = bgzf_read(f, buf, sizeof(buf));
+    bgzf_close(f);
+
+    REQUIRE(std::string(buf, n) == "chrT\tR_1\nchr1\tR_2\n");
+}
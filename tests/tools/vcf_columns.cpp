@@ -0,0 +1,183 @@
+#include <thread>
+#include <fstream>
+#include <catch.hpp>
+#include "data/snapshot.hpp"
+#include "tools/vcf_columns.hpp"
+
+using namespace Anaquin;
+
+static bool same(double x, double y)
+{
+    return (std::isnan(x) && std::isnan(y)) || x == y;
+}
+
+// Same variants and queries as VCFData
+static void requireEqual(const VCFData &x, const VCFColumns &y)
+{
+    REQUIRE(x.size() == y.size());
+    REQUIRE(x.countSNP() == y.countSNP());
+    REQUIRE(x.countInd() == y.countInd());
+    REQUIRE(x.hist() == y.hist());
+
+    for (const auto &i : x)
+    {
+        REQUIRE(x.countSNP(i.first) == y.countSNP(i.first));
+        REQUIRE(x.countInd(i.first) == y.countInd(i.first));
+
+        for (const auto *m : { &i.second.s2d, &i.second.i2d })
+        {
+            for (const auto &j : *m)
+            {
+                const auto &v = j.second;
+                const auto *a = x.findVar(i.first, v.key());
+                const auto *b = y.findVar(i.first, v.key());
+
+                REQUIRE(b);
+                REQUIRE(b == y.findVar(i.first, v.key()));
+                REQUIRE(a->l == b->l);
+                REQUIRE(a->id == b->id);
+
+                const auto *c = y.findVar(i.first, v.l);
+
+                REQUIRE(c);
+                REQUIRE(c->cID == v.cID);
+                REQUIRE(c->id  == x.findVar(i.first, v.l)->id);
+                REQUIRE(c->ref == x.findVar(i.first, v.l)->ref);
+                REQUIRE(c->alt == x.findVar(i.first, v.l)->alt);
+                REQUIRE(c->type() == x.findVar(i.first, v.l)->type());
+                REQUIRE(same(c->qual, x.findVar(i.first, v.l)->qual));
+            }
+        }
+    }
+}
+
+TEST_CASE("VCFColumns_Synthetic")
+{
+    const auto x = vcfData(Reader("data/VarQuin/AVA009_v001.vcf"));
+    const auto y = vcfColumns(Reader("data/VarQuin/AVA009_v001.vcf"));
+
+    requireEqual(x, y);
+
+    REQUIRE(y.countInd() == 108);
+    REQUIRE(y.countSNP() == 137);
+
+    // Every line has AF, AD and DP
+    for (const auto &i : x.at("chrIS").s2d)
+    {
+        const auto *v = y.findVar("chrIS", i.second.l);
+
+        REQUIRE(same(v->allF,  i.second.allF));
+        REQUIRE(same(v->readR, i.second.readR));
+        REQUIRE(same(v->readV, i.second.readV));
+        REQUIRE(same(v->depth, i.second.depth));
+    }
+
+    requireEqual(vcfData(Reader("tests/data/AVA026_v001.vcf")), vcfColumns(Reader("tests/data/AVA026_v001.vcf")));
+}
+
+TEST_CASE("VCFColumns_Unsorted")
+{
+    // Unsorted, repeated positions (the last wins), multiple alleles and non-variants
+    const auto file = "/tmp/VCFColumns_Unsorted.vcf";
+
+    std::ofstream o(file);
+    o << "##fileformat=VCFv4.2\n";
+    o << "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\n";
+    o << "chr2\t300\tS3\tA\tG\t10\tPASS\tAF=0.5\n";
+    o << "chr1\t200\tS2\tC\tT\t.\tPASS\t.\n";
+    o << "chr1\t100\tS1\tA\tG,T\t20\tPASS\tDP=5\n";
+    o << "chr1\t200\tS2B\tC\tG\t30\tPASS\t.\n";
+    o << "chr1\t150\tD1\tACGT\tA\t40\tPASS\t.\n";
+    o << "chr1\t150\tI1\tA\tACGT\t50\tPASS\t.\n";
+    o << "chr1\t250\tN1\tA\t.\t50\tPASS\t.\n";
+    o << "chr2\t50\tD2\tAA\tA\t60\tPASS\t.\n";
+    o.close();
+
+    const auto x = vcfData(Reader(file));
+    const auto y = vcfColumns(Reader(file));
+
+    requireEqual(x, y);
+
+    REQUIRE(y.at("chr1").snps == 2);
+    REQUIRE(y.at("chr1").size() == 3);
+    REQUIRE(y.findVar("chr1", Locus(200, 200))->id == "S2B");
+    REQUIRE(y.findVar("chr1", Locus(150, 150))->id == "I1");
+    REQUIRE(y.findVar("chr1", Locus(100, 100))->alt == "G");
+    REQUIRE(y.findVar("chr2", Locus(300, 300))->allF == Approx(0.5));
+    REQUIRE(!y.findVar("chr1", Locus(250, 250)));
+    REQUIRE(!y.findVar("chr3", Locus(300, 300)));
+    REQUIRE(!y.findVar("chr1", 0));
+
+    unlink(file);
+}
+
+TEST_CASE("VCFColumns_Snapshot")
+{
+    Snapshot::dir = "/tmp";
+
+    const auto r = Reader("data/VarQuin/AVA009_v001.vcf");
+    const auto file = Snapshot::path(r.hash(), "test-columns");
+
+    unlink(file.c_str());
+
+    auto parsed = 0;
+
+    auto parse = [&](const Reader &r)
+    {
+        parsed++;
+        return vcfColumns(r);
+    };
+
+    const auto x = Snapshot::cached<VCFColumns>(r, "test-columns", parse);
+    const auto y = Snapshot::cached<VCFColumns>(r, "test-columns", parse);
+
+    REQUIRE(parsed == 1);
+
+    for (const auto &i : x)
+    {
+        const auto &j = y.at(i.first);
+
+        REQUIRE(i.second.snps   == j.snps);
+        REQUIRE(i.second.starts == j.starts);
+        REQUIRE(i.second.offs   == j.offs);
+        REQUIRE(i.second.arena  == j.arena);
+        REQUIRE(i.second.keys   == j.keys);
+        REQUIRE(i.second.rows   == j.rows);
+    }
+
+    requireEqual(vcfData(r), y);
+
+    Snapshot::dir.clear();
+    unlink(file.c_str());
+}
+
+TEST_CASE("VCFColumns_Threads")
+{
+    const auto x = vcfColumns(Reader("data/VarQuin/AVA009_v001.vcf"));
+    const auto &c = x.at("chrIS");
+
+    std::vector<std::vector<const Variant *>> found(4);
+    std::vector<std::thread> ts;
+
+    for (auto &i : found)
+    {
+        ts.push_back(std::thread([&]()
+        {
+            for (auto j = 0u; j < c.size(); j++)
+            {
+                i.push_back(x.findVar("chrIS", Locus(c.starts[j], c.starts[j])));
+            }
+        }));
+    }
+
+    for (auto &t : ts)
+    {
+        t.join();
+    }
+
+    // Every thread sees the same decoded variants
+    for (const auto &i : found)
+    {
+        REQUIRE(i == found[0]);
+    }
+}
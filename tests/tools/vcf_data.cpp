@@ -13,4 +13,76 @@ TEST_CASE("VCF_Synthetic")
     REQUIRE(r.countSNP()    == 137);
     REQUIRE(r.countSNPSyn() == 137);
     REQUIRE(r.countSNPGen() == 0);    
-}
\ No newline at end of file
+}
+
+// Key and search before the variants were indexed
+static long oldHash(const Variant &x)
+{
+    const auto str = (boost::format("%1%_%2%_%3%_%4%") % x.id % x.type() % x.l.start % x.l.end).str();
+    return std::hash<std::string>{}(str);
+}
+
+static const Variant *oldFind(const VCFData &x, const ChrID &cID, long key)
+{
+    if (x.count(cID))
+    {
+        for (const auto &j : x.at(cID).s2d) { if (key == oldHash(j.second)) { return &j.second; } }
+        for (const auto &j : x.at(cID).i2d) { if (key == oldHash(j.second)) { return &j.second; } }
+    }
+
+    return nullptr;
+}
+
+TEST_CASE("VCF_FindVar")
+{
+    auto x = vcfData(Reader("tests/data/varscan.tab"), VarFormat::VarScan);
+
+    // Indels with IDs, negative positions aren't expected but must hash the same
+    for (auto i = 0; i < 100; i++)
+    {
+        Variant v;
+
+        v.cID = "chrIS";
+        v.id  = "D_" + std::to_string(i);
+        v.l   = Locus(i * 10 - 50, i * 10 - 48);
+        v.ref = "AAA";
+        v.alt = "A";
+
+        x["chrIS"].i2d[v.l.start] = v;
+    }
+
+    x.index();
+
+    auto n = 0;
+
+    for (const auto &i : x)
+    {
+        for (const auto *m : { &i.second.s2d, &i.second.i2d })
+        {
+            for (const auto &j : *m)
+            {
+                REQUIRE(j.second.key() == oldHash(j.second));
+                REQUIRE(x.findVar(i.first, j.second.key()) == oldFind(x, i.first, j.second.key()));
+                n++;
+            }
+        }
+    }
+
+    REQUIRE(n > 100);
+    REQUIRE(!x.findVar("chrIS", 0));
+    REQUIRE(!x.findVar("chr1", x.at("chrIS").i2d.begin()->second.key()));
+
+    // Copies are indexed on their own
+    const auto y = std::make_shared<VCFData>(x);
+    const auto &v = y->at("chrIS").i2d.begin()->second;
+
+    REQUIRE(y->findVar("chrIS", v.key()) == &v);
+
+    // Adding a variant needs the variants indexed again
+    auto w = v;
+    w.id = "D_100";
+    addVar(x, w);
+    x.index();
+
+    REQUIRE(x.findVar("chrIS", w.key())->id == "D_100");
+}